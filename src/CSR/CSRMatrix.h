@@ -1,10 +1,18 @@
 /*
     CSRMatrix.h
-    
+
     This class represents a sparse matrix in Compressed Sparse Row (CSR) format.
     It provides methods to build the CSR representation from a list of entries in coordinate format.
 
-    Therare no setter methodds because the matrix is meant to be built once from entries.
+    The class is a template over the value type (double or float: single
+    precision halves the dominant memory traffic of this bandwidth-bound
+    kernel) and the index type (int by default; long long for matrices beyond
+    2^31 nonzeros, enabled project-wide with the SPMV_IDX64 build flag, see
+    "make help"). Being a template, the implementation lives entirely in this
+    header; the plain CSRMatrix name stays as an alias for the default
+    instantiation so existing code reads as before.
+
+    There are no setter methods because the matrix is meant to be built once from entries.
 */
 
 #ifndef CSRMATRIX_H
@@ -14,39 +22,373 @@
 #include <string>
 #include <stdexcept>
 #include <iostream>
-#include <algorithm> // per std::max_element
+#include <fstream>
+#include <algorithm>
+#include <sys/stat.h> // stat, to compare .mtx and .csrbin timestamps
 #include "MTX/MTXReader.h"
 
 using namespace std;
 using mtx::Entry;
 
-class CSRMatrix {
+// Magic number and version identifying the binary sidecar format.
+// Version 2 records the value/index byte widths so differently-typed
+// instantiations never read each other's caches; version 3 adds a flags
+// word recording half-stored symmetric/skew matrices.
+static const int CSRBIN_MAGIC = 0x43535242; // "CSRB"
+static const int CSRBIN_VERSION = 3;
+static const int CSRBIN_FLAG_HALF = 1; // only the lower triangle is stored
+static const int CSRBIN_FLAG_SKEW = 2; // mirrored entries are negated
+
+// Default index type for the whole project (see Makefile INDEX64 knob)
+#ifdef SPMV_IDX64
+typedef long long csr_index_t;
+#else
+typedef int csr_index_t;
+#endif
+
+template <typename ValueT = double, typename IndexT = csr_index_t>
+class CSRMatrixT {
 private:
-    int *indexPointers;
-    int *indices;
-    double *data;
-    int rows, cols, nnz;
+    IndexT *indexPointers;
+    IndexT *indices;
+    ValueT *data;
+    IndexT rows, cols, nnz;
+    bool halfStored; // only the stored triangle of a symmetric file is kept
+    bool skewStored; // the implicit mirrored entries are negated
+
+    // Keep columns sorted within each row (kernels and debugging rely on it).
+    // The counting builds preserve scan order, which is almost always already
+    // sorted, so this usually reduces to a check; unsorted rows get an
+    // insertion sort.
+    void sortRowsInPlace() {
+        for (IndexT r = 0; r < rows; r++) {
+            for (IndexT j = indexPointers[r] + 1; j < indexPointers[r + 1]; j++) {
+                IndexT col = indices[j];
+                ValueT val = data[j];
+                IndexT k = j - 1;
+                while (k >= indexPointers[r] && indices[k] > col) {
+                    indices[k + 1] = indices[k];
+                    data[k + 1] = data[k];
+                    k--;
+                }
+                indices[k + 1] = col;
+                data[k + 1] = val;
+            }
+        }
+    }
+
+    // Modification time of a file, or -1 if it does not exist
+    static long fileMTime(const string& path) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) return -1;
+        return (long)st.st_mtime;
+    }
+
+    // Sidecar name: the default instantiation keeps the plain ".csrbin",
+    // other type combinations get a typed suffix so caches can coexist
+    static string cacheSuffix() {
+        if (sizeof(ValueT) == 8 && sizeof(IndexT) == 4) return ".csrbin";
+        return ".v" + to_string(sizeof(ValueT)) + "i" + to_string(sizeof(IndexT)) + ".csrbin";
+    }
 
 public:
-    CSRMatrix();
-    ~CSRMatrix();
+    typedef ValueT value_type;
+    typedef IndexT index_type;
+
+    // Storage format tag, reported in the results JSON (see also SELLMatrixT)
+    static string formatName() { return "csr"; }
+
+    // Sidecar path for a given .mtx file (used by the out-of-core streaming
+    // engine, which reads the sidecar directly instead of loading the matrix)
+    static string sidecarPath(const string& mtxPath) { return mtxPath + cacheSuffix(); }
+
+    // Constructor set members to zero/nullptr
+    CSRMatrixT() : indexPointers(nullptr), indices(nullptr), data(nullptr), rows(0), cols(0), nnz(0),
+                   halfStored(false), skewStored(false) {}
+
+    ~CSRMatrixT() {
+        clear();
+    }
 
     // Data accessors
-    int getRows() const { return rows; }
-    int getCols() const { return cols; }
-    int getNNZ() const { return nnz; }
-    const int getIndexPointers(int i) const { return indexPointers[i]; }
-    const int getIndices(int i) const { return indices[i]; }
-    const double getData(int i) const { return data[i]; }
+    IndexT getRows() const { return rows; }
+    IndexT getCols() const { return cols; }
+    IndexT getNNZ() const { return nnz; }
+    bool isHalfStored() const { return halfStored; }
+    bool isSkewStored() const { return skewStored; }
+    const IndexT getIndexPointers(IndexT i) const { return indexPointers[i]; }
+    const IndexT getIndices(IndexT i) const { return indices[i]; }
+    const ValueT getData(IndexT i) const { return data[i]; }
+
+    // Raw array accessors for kernels that need direct pointers (e.g. SIMD gathers)
+    const IndexT* getIndexPointersPtr() const { return indexPointers; }
+    const IndexT* getIndicesPtr() const { return indices; }
+    const ValueT* getDataPtr() const { return data; }
+
+    // Free allocated memory and reset the matrix
+    void clear() {
+        delete[] indexPointers;
+        delete[] indices;
+        delete[] data;
+        indexPointers = nullptr;
+        indices = nullptr;
+        data = nullptr;
+        rows = cols = nnz = 0;
+        halfStored = skewStored = false;
+    }
+
+    // Build CSR from entries (row, col, value) with a counting build:
+    // count nonzeros per row, prefix-sum into indexPointers, then scatter each
+    // entry into its final slot in one pass. This is O(nnz) and does not require
+    // the entries to be sorted, so readMTX no longer needs a global std::sort.
+    void buildFromEntries(const vector<Entry>& entries) {
+        if (entries.empty())
+            throw runtime_error("Cannot build CSR: entries vector is empty.");
+
+        // For safety, clear any existing data
+        clear();
+
+        nnz = (IndexT)entries.size();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if ((IndexT)entries[i].row >= rows) rows = (IndexT)entries[i].row + 1;
+            if ((IndexT)entries[i].col >= cols) cols = (IndexT)entries[i].col + 1;
+        }
+
+        // Allocate CSR arrays
+        indexPointers = new IndexT[rows + 1]; // +1 for the end pointer
+        indices = new IndexT[nnz];
+        data = new ValueT[nnz];
+        if (!indexPointers || !indices || !data)
+            throw runtime_error("Memory allocation failed.");
+
+        // Pass 1: count nonzeros per row (stored shifted by one for the prefix sum)
+        for (IndexT i = 0; i <= rows; i++) indexPointers[i] = 0;
+        for (size_t i = 0; i < entries.size(); i++)
+            indexPointers[entries[i].row + 1]++;
+
+        // Prefix sum: indexPointers[r] becomes the start offset of row r
+        for (IndexT r = 0; r < rows; r++)
+            indexPointers[r + 1] += indexPointers[r];
+
+        // Pass 2: scatter entries into their final slots.
+        // 'next' tracks the write cursor of each row.
+        vector<IndexT> next(indexPointers, indexPointers + rows);
+        for (size_t i = 0; i < entries.size(); i++) {
+            const Entry& entry = entries[i];
+            IndexT dst = next[entry.row]++;
+            indices[dst] = (IndexT)entry.col;
+            data[dst] = (ValueT)entry.value;
+        }
+
+        sortRowsInPlace();
+    }
+
+    // Streaming construction: parse the .mtx twice through an MTXFile cursor
+    // and write indices/data straight into their final slots — the same
+    // counting build as buildFromEntries, but without ever materializing the
+    // 16-byte-per-nnz Entry vector (whose copy put peak load memory at ~2.3x
+    // the finished matrix). Only the mapped file text, which the kernel can
+    // evict page by page, is live alongside the CSR arrays. The parse is
+    // single-threaded, so cold-cache loads of huge files trade some speed for
+    // the footprint; warm loads go through the binary sidecar anyway.
+    // Returns false when the file cannot be mmap'd (caller falls back).
+    bool buildFromMTXStream(const string& mtxPath, const string& symmetryMode = "expand") {
+        mtx::MTXFile file;
+        if (!file.open(mtxPath))
+            return false;
+        const mtx::MTXHeader& header = file.getHeader();
+        bool mirror = header.symmetric && (symmetryMode != "half");
+
+        clear();
+        rows = (IndexT)header.rows;
+        cols = (IndexT)header.cols;
+
+        // Pass 1: count nonzeros per row (plus the mirrored triangle when
+        // a symmetric file is being expanded)
+        indexPointers = new IndexT[rows + 1];
+        for (IndexT i = 0; i <= rows; i++) indexPointers[i] = 0;
+        int r, c;
+        double v;
+        long long total = 0;
+        while (file.next(r, c, v)) {
+            indexPointers[r + 1]++;
+            total++;
+            if (mirror && r != c) {
+                indexPointers[c + 1]++;
+                total++;
+            }
+        }
+        if (total == 0)
+            throw runtime_error("No entries read from file: " + mtxPath);
+        nnz = (IndexT)total;
 
-    // Build CSR from entries containing <row, col, value> triplets
-    void buildFromEntries(const vector<Entry>& entries);
+        // Prefix sum: indexPointers[r] becomes the start offset of row r
+        for (IndexT row = 0; row < rows; row++)
+            indexPointers[row + 1] += indexPointers[row];
+
+        // Pass 2: re-parse and scatter each entry (and its mirror) into place
+        indices = new IndexT[nnz];
+        data = new ValueT[nnz];
+        vector<IndexT> next(indexPointers, indexPointers + rows);
+        file.rewind();
+        while (file.next(r, c, v)) {
+            IndexT dst = next[r]++;
+            indices[dst] = (IndexT)c;
+            data[dst] = (ValueT)v;
+            if (mirror && r != c) {
+                dst = next[c]++;
+                indices[dst] = (IndexT)r;
+                data[dst] = (ValueT)(header.skew ? -v : v);
+            }
+        }
+
+        sortRowsInPlace();
+
+        if (header.symmetric && symmetryMode == "half") {
+            halfStored = true;
+            skewStored = header.skew;
+        }
+        return true;
+    }
+
+    // Load from a .mtx file, going through the binary sidecar when possible.
+    // The sidecar is only trusted if it is newer than the .mtx file, so editing
+    // or replacing the matrix invalidates the cache automatically.
+    //
+    // symmetryMode controls what happens to symmetric/skew-symmetric files:
+    //   "expand" (default) mirrors the stored triangle so every kernel works
+    //   "half" keeps only the stored triangle (halved footprint) and marks the
+    //          matrix half-stored for the symmetry-exploiting kernel
+    // General files are unaffected by the mode. Half-stored matrices use their
+    // own sidecar suffix so the two representations never share a cache.
+    void loadFromMTX(const string& mtxPath, const string& symmetryMode = "expand") {
+        bool wantHalf = (symmetryMode == "half");
+        string binPath = mtxPath + (wantHalf ? ".half" + cacheSuffix() : cacheSuffix());
+
+        long mtxTime = fileMTime(mtxPath);
+        long binTime = fileMTime(binPath);
+
+        if (binTime >= 0 && binTime >= mtxTime && loadBinary(binPath))
+            return; // fast path: bulk-read the finished CSR arrays
+
+        // Slow path: stream the .mtx straight into the CSR arrays, never
+        // materializing the intermediate Entry vector; the Entry-vector build
+        // remains as fallback for files that cannot be memory-mapped
+        if (!buildFromMTXStream(mtxPath, symmetryMode)) {
+            mtx::MTXHeader header;
+            vector<Entry> entries = mtx::readMTX(mtxPath, &header);
+            if (header.symmetric && !wantHalf)
+                mtx::expandSymmetric(entries, header.skew);
+            buildFromEntries(entries);
+            if (header.symmetric && wantHalf) {
+                halfStored = true;
+                skewStored = header.skew;
+            }
+        }
+
+        // Caching is best-effort: a read-only directory must not fail the run
+        try {
+            saveBinary(binPath);
+        } catch (const exception&) {}
+    }
+
+    // Serialize header + CSR arrays with three bulk writes
+    void saveBinary(const string& binPath) const {
+        if (nnz == 0)
+            throw runtime_error("Cannot save empty CSR matrix.");
+
+        ofstream file(binPath, ios::binary | ios::trunc);
+        if (!file.is_open())
+            throw runtime_error("Cannot open file for writing: " + binPath);
+
+        int storageFlags = (halfStored ? CSRBIN_FLAG_HALF : 0) | (skewStored ? CSRBIN_FLAG_SKEW : 0);
+        int header[5] = { CSRBIN_MAGIC, CSRBIN_VERSION, (int)sizeof(ValueT), (int)sizeof(IndexT), storageFlags };
+        long long dims[3] = { (long long)rows, (long long)cols, (long long)nnz };
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+        file.write(reinterpret_cast<const char*>(indexPointers), sizeof(IndexT) * (rows + 1));
+        file.write(reinterpret_cast<const char*>(indices), sizeof(IndexT) * nnz);
+        file.write(reinterpret_cast<const char*>(data), sizeof(ValueT) * nnz);
+
+        if (!file.good())
+            throw runtime_error("Failed to write binary CSR file: " + binPath);
+    }
+
+    // Deserialize the CSR arrays; returns false on a missing/corrupt/stale-format
+    // sidecar so the caller can fall back to the .mtx parser.
+    bool loadBinary(const string& binPath) {
+        ifstream file(binPath, ios::binary);
+        if (!file.is_open()) return false;
+
+        int header[5];
+        long long dims[3];
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+        if (!file.good() || header[0] != CSRBIN_MAGIC || header[1] != CSRBIN_VERSION)
+            return false;
+        if (header[2] != (int)sizeof(ValueT) || header[3] != (int)sizeof(IndexT))
+            return false;
+        if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0)
+            return false;
+
+        clear();
+        rows = (IndexT)dims[0];
+        cols = (IndexT)dims[1];
+        nnz = (IndexT)dims[2];
+        halfStored = (header[4] & CSRBIN_FLAG_HALF) != 0;
+        skewStored = (header[4] & CSRBIN_FLAG_SKEW) != 0;
+
+        indexPointers = new IndexT[rows + 1];
+        indices = new IndexT[nnz];
+        data = new ValueT[nnz];
+
+        file.read(reinterpret_cast<char*>(indexPointers), sizeof(IndexT) * (rows + 1));
+        file.read(reinterpret_cast<char*>(indices), sizeof(IndexT) * nnz);
+        file.read(reinterpret_cast<char*>(data), sizeof(ValueT) * nnz);
+
+        if (!file.good()) { // truncated file: drop partial data and reparse
+            clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    // Replace the internal arrays with caller-initialized copies of the same
+    // sizes, taking ownership. Used by the NUMA placement pass in spmvParallel,
+    // which must first-touch the pages from the worker threads.
+    void replaceArrays(IndexT* newIndexPointers, IndexT* newIndices, ValueT* newData) {
+        if (!newIndexPointers || !newIndices || !newData)
+            throw runtime_error("replaceArrays: null buffer.");
+        delete[] indexPointers;
+        delete[] indices;
+        delete[] data;
+        indexPointers = newIndexPointers;
+        indices = newIndices;
+        data = newData;
+    }
 
     // For debugging
-    void print() const;
+    void print() const {
+        cout << "\nCSR Matrix:\n";
+        cout << "Rows: " << rows << " Cols: " << cols << " NNZ: " << nnz << "\n";
 
-    // Free allocated memory and reset the matrix
-    void clear();
+        cout << "IndexPointers: ";
+        for (IndexT i = 0; i <= rows; ++i) cout << indexPointers[i] << " ";
+        cout << "\n";
+
+        cout << "Indices: ";
+        for (IndexT i = 0; i < nnz; ++i) cout << indices[i] << " ";
+        cout << "\n";
+
+        cout << "Data: ";
+        for (IndexT i = 0; i < nnz; ++i) cout << data[i] << " ";
+        cout << "\n";
+    }
 };
 
-#endif // CSRMATRIX_H
\ No newline at end of file
+// The historical non-template name keeps working everywhere
+typedef CSRMatrixT<double, csr_index_t> CSRMatrix;
+typedef CSRMatrixT<float, csr_index_t> CSRMatrixF;
+
+#endif // CSRMATRIX_H
@@ -0,0 +1,170 @@
+/*
+    DCSRMatrix.h
+
+    This class represents a sparse matrix in CSR layout with a delta-compressed
+    column index stream.
+
+    The warm-up accounting shows that the 4 bytes of column index traffic per
+    nonzero are roughly a third of the kernel's total bytes on fp64 (more on
+    fp32). Since buildFromEntries keeps columns sorted within each row, the
+    column deltas are small — on banded matrices almost always below 252 — so
+    the indices are stored as a per-row byte stream instead of a flat IndexT
+    array:
+
+      byte 0..251          delta from the previous column (first entry: from 0)
+      byte 252 + 2 bytes   16-bit little-endian delta (large jump)
+      byte 253 + 4 bytes   32-bit little-endian delta (escape, always fits)
+
+    A per-row byte offset array lets every row decode independently, so the
+    kernel parallelizes exactly like plain CSR and decodes on the fly. Values
+    keep the usual flat layout; only the index stream changes.
+
+    Like CSRMatrixT the class is a template over the value and index types and
+    lives entirely in this header; it is built from the same vector<Entry>
+    that readMTX produces.
+*/
+
+#ifndef DCSRMATRIX_H
+#define DCSRMATRIX_H
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include "CSR/CSRMatrix.h" // csr_index_t, Entry
+
+using namespace std;
+using mtx::Entry;
+
+template <typename ValueT = double, typename IndexT = csr_index_t>
+class DCSRMatrixT {
+private:
+    IndexT rows, cols, nnz;
+    IndexT *rowPtr;          // rows+1 offsets into data (entry counts, as in CSR)
+    long long *bytePtr;      // rows+1 offsets into the compressed index stream
+    unsigned char *stream;   // delta-encoded column indices, grouped by row
+    ValueT *data;            // values in the usual flat CSR order
+
+public:
+    typedef ValueT value_type;
+    typedef IndexT index_type;
+
+    static string formatName() { return "dcsr"; }
+
+    DCSRMatrixT() : rows(0), cols(0), nnz(0),
+                    rowPtr(nullptr), bytePtr(nullptr), stream(nullptr), data(nullptr) {}
+
+    ~DCSRMatrixT() {
+        clear();
+    }
+
+    // Data accessors
+    IndexT getRows() const { return rows; }
+    IndexT getCols() const { return cols; }
+    IndexT getNNZ() const { return nnz; }
+    long long getStreamBytes() const { return rows ? bytePtr[rows] : 0; }
+    bool isHalfStored() const { return false; } // only CSR supports -M=half
+    bool isSkewStored() const { return false; }
+
+    // Raw array accessors for the kernel
+    const IndexT* getRowPtr() const { return rowPtr; }
+    const long long* getBytePtr() const { return bytePtr; }
+    const unsigned char* getStreamPtr() const { return stream; }
+    const ValueT* getDataPtr() const { return data; }
+
+    // Free allocated memory and reset the matrix
+    void clear() {
+        delete[] rowPtr;
+        delete[] bytePtr;
+        delete[] stream;
+        delete[] data;
+        rowPtr = nullptr;
+        bytePtr = nullptr;
+        stream = nullptr;
+        data = nullptr;
+        rows = cols = nnz = 0;
+    }
+
+    // Build from coordinate entries: the same O(nnz) counting build and
+    // per-row column sort as CSRMatrixT, followed by the delta encoding pass.
+    void buildFromEntries(const vector<Entry>& entries) {
+        if (entries.empty())
+            throw runtime_error("Cannot build DCSR: entries vector is empty.");
+
+        clear();
+
+        nnz = (IndexT)entries.size();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if ((IndexT)entries[i].row >= rows) rows = (IndexT)entries[i].row + 1;
+            if ((IndexT)entries[i].col >= cols) cols = (IndexT)entries[i].col + 1;
+        }
+
+        // Counting build into temporary column/value arrays
+        rowPtr = new IndexT[rows + 1];
+        for (IndexT i = 0; i <= rows; i++) rowPtr[i] = 0;
+        for (size_t i = 0; i < entries.size(); i++)
+            rowPtr[entries[i].row + 1]++;
+        for (IndexT r = 0; r < rows; r++)
+            rowPtr[r + 1] += rowPtr[r];
+
+        vector<IndexT> cols_(nnz);
+        data = new ValueT[nnz];
+        vector<IndexT> next(rowPtr, rowPtr + rows);
+        for (size_t i = 0; i < entries.size(); i++) {
+            IndexT dst = next[entries[i].row]++;
+            cols_[dst] = (IndexT)entries[i].col;
+            data[dst] = (ValueT)entries[i].value;
+        }
+
+        // Keep columns sorted within each row: the delta encoding depends on it
+        for (IndexT r = 0; r < rows; r++) {
+            for (IndexT j = rowPtr[r] + 1; j < rowPtr[r + 1]; j++) {
+                IndexT col = cols_[j];
+                ValueT val = data[j];
+                IndexT k = j - 1;
+                while (k >= rowPtr[r] && cols_[k] > col) {
+                    cols_[k + 1] = cols_[k];
+                    data[k + 1] = data[k];
+                    k--;
+                }
+                cols_[k + 1] = col;
+                data[k + 1] = val;
+            }
+        }
+
+        // Delta-encode the column stream row by row
+        vector<unsigned char> buf;
+        buf.reserve((size_t)nnz + rows); // common case: one byte per entry
+        bytePtr = new long long[rows + 1];
+        bytePtr[0] = 0;
+        for (IndexT r = 0; r < rows; r++) {
+            IndexT prev = 0;
+            for (IndexT j = rowPtr[r]; j < rowPtr[r + 1]; j++) {
+                unsigned long long delta = (unsigned long long)(cols_[j] - prev);
+                prev = cols_[j];
+                if (delta < 252) {
+                    buf.push_back((unsigned char)delta);
+                } else if (delta < 65536) {
+                    buf.push_back(252);
+                    buf.push_back((unsigned char)(delta & 0xFF));
+                    buf.push_back((unsigned char)(delta >> 8));
+                } else {
+                    buf.push_back(253);
+                    buf.push_back((unsigned char)(delta & 0xFF));
+                    buf.push_back((unsigned char)((delta >> 8) & 0xFF));
+                    buf.push_back((unsigned char)((delta >> 16) & 0xFF));
+                    buf.push_back((unsigned char)((delta >> 24) & 0xFF));
+                }
+            }
+            bytePtr[r + 1] = (long long)buf.size();
+        }
+
+        stream = new unsigned char[buf.size()];
+        copy(buf.begin(), buf.end(), stream);
+    }
+};
+
+// Default instantiation, mirroring the CSRMatrix alias
+typedef DCSRMatrixT<double, csr_index_t> DCSRMatrix;
+
+#endif // DCSRMATRIX_H
@@ -32,7 +32,102 @@ namespace mtx {
         double value;
     };
 
-    vector<Entry> readMTX(const string& filePath);
+    // Parsed "%%MatrixMarket matrix coordinate <field> <symmetry>" banner.
+    // For symmetric/skew files only the stored triangle is returned; callers
+    // either expand it (expandSymmetric) or use a symmetry-aware kernel.
+    struct MTXHeader {
+        int rows = 0, cols = 0;
+        long nnz = 0;            // stored entries, not the logical nonzero count
+        bool symmetric = false;
+        bool skew = false;       // skew-symmetric: mirrored entries are negated
+        bool pattern = false;    // pattern field: entries have no value (taken as 1.0)
+    };
+
+    vector<Entry> readMTX(const string& filePath, MTXHeader* header = nullptr);
+
+    // Append the mirrored off-diagonal entries of a symmetric/skew triangle
+    void expandSymmetric(vector<Entry>& entries, bool skew);
+
+    // ------------------------------------------------------------------
+    // Hand-rolled scanners over a raw character range.
+    // They advance 'p' past the parsed token; no locale, no iostreams.
+    // Inline here so both the parallel reader and MTXFile::next use them.
+    // ------------------------------------------------------------------
+
+    inline void skipSpaces(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+            ++p;
+    }
+
+    inline long parseInt(const char*& p, const char* end) {
+        bool neg = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            neg = (*p == '-');
+            ++p;
+        }
+        long v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + (*p - '0');
+            ++p;
+        }
+        return neg ? -v : v;
+    }
+
+    double parseDouble(const char*& p, const char* end);
+
+    /*
+        Streaming cursor over a memory-mapped .mtx file.
+
+        readMTX materializes every nonzero as a 16-byte Entry before the CSR
+        build copies it again, so peak load memory is ~2.3x the final matrix.
+        MTXFile instead exposes the entry section one record at a time: open()
+        maps the file and parses the banner and dimension line, next() scans
+        one entry per call, rewind() restarts for a second pass. The CSR
+        counting build (CSRMatrixT::buildFromMTXStream) walks the file twice
+        through this cursor and writes straight into its final arrays, so
+        nothing but the mapped (page-evictable) file text is live alongside
+        the matrix. The one object of state justifies a class where the rest
+        of this module is free functions.
+    */
+    class MTXFile {
+    private:
+        MTXHeader header;
+        const char* mapBase = nullptr;
+        size_t mapSize = 0;
+        const char* entriesBegin = nullptr;
+        const char* entriesEnd = nullptr;
+        const char* cursor = nullptr;
+
+    public:
+        MTXFile() = default;
+        ~MTXFile() { close(); }
+
+        // Map the file and parse banner + dimensions; false when the file
+        // cannot be mapped (the caller falls back to the Entry-vector path)
+        bool open(const string& filePath);
+        void close();
+
+        const MTXHeader& getHeader() const { return header; }
+
+        // Restart at the first entry (for the second pass of a counting build)
+        void rewind() { cursor = entriesBegin; }
+
+        // Scan the next entry (0-based indices); false at end of file.
+        // Pattern files carry no value column: every entry counts as 1.0.
+        bool next(int& row, int& col, double& value) {
+            skipSpaces(cursor, entriesEnd);
+            if (cursor >= entriesEnd) return false;
+            row = (int)parseInt(cursor, entriesEnd) - 1;
+            skipSpaces(cursor, entriesEnd);
+            col = (int)parseInt(cursor, entriesEnd) - 1;
+            value = 1.0;
+            if (!header.pattern) {
+                skipSpaces(cursor, entriesEnd);
+                value = parseDouble(cursor, entriesEnd);
+            }
+            return true;
+        }
+    };
 
 } // namespace mtx
 
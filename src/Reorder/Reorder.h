@@ -0,0 +1,120 @@
+/*
+    Reorder.h
+
+    Row/column reordering as a preprocessing stage (-R=rcm).
+
+    Matrices with scattered column patterns pay heavy cache misses on the
+    x[col] gather because consecutive rows touch far-apart parts of x. A
+    bandwidth-reducing permutation clusters each row's columns near the
+    diagonal, so the gather works on a small sliding window of x that stays
+    cached. The functions here operate on the coordinate entry list between
+    readMTX and buildFromEntries, so every storage format benefits from the
+    same pass.
+
+    rcmPermutation implements Reverse Cuthill-McKee: breadth-first traversal
+    of the symmetrized sparsity pattern starting from a minimum-degree vertex
+    of each component, visiting neighbors in ascending degree order, with the
+    final order reversed. The achieved bandwidth before/after is reported in
+    the scenario JSON so runs document what the pass actually bought.
+
+    The permutation is applied symmetrically (rows and columns alike), which
+    keeps y = Ax equivalent up to the same relabeling of both vectors; a
+    solver would apply the inverse permutation to y once after the solve.
+*/
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <vector>
+#include <algorithm>
+#include "MTX/MTXReader.h" // Entry
+
+using namespace std;
+
+namespace reorder {
+
+    // Largest |row - col| over the entries: the matrix bandwidth
+    inline long long matrixBandwidth(const vector<mtx::Entry>& entries) {
+        long long bw = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            long long d = (long long)entries[i].row - entries[i].col;
+            if (d < 0) d = -d;
+            if (d > bw) bw = d;
+        }
+        return bw;
+    }
+
+    // Reverse Cuthill-McKee permutation of the n x n pattern given by the
+    // entries. Returns newOf with newOf[oldIndex] = newIndex. The adjacency
+    // is symmetrized (an entry connects its row and column both ways) so
+    // general matrices reorder as well as structurally symmetric ones.
+    inline vector<int> rcmPermutation(const vector<mtx::Entry>& entries, int n) {
+        // Build the adjacency in CSR-like arrays (off-diagonal, both directions)
+        vector<int> deg(n, 0);
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].row == entries[i].col) continue;
+            deg[entries[i].row]++;
+            deg[entries[i].col]++;
+        }
+        vector<long long> adjPtr(n + 1, 0);
+        for (int v = 0; v < n; v++)
+            adjPtr[v + 1] = adjPtr[v] + deg[v];
+        vector<int> adj(adjPtr[n]);
+        {
+            vector<long long> next(adjPtr.begin(), adjPtr.begin() + n);
+            for (size_t i = 0; i < entries.size(); i++) {
+                if (entries[i].row == entries[i].col) continue;
+                adj[next[entries[i].row]++] = entries[i].col;
+                adj[next[entries[i].col]++] = entries[i].row;
+            }
+        }
+
+        // Component seeds in ascending degree order (the classic CM start)
+        vector<int> seeds(n);
+        for (int v = 0; v < n; v++) seeds[v] = v;
+        sort(seeds.begin(), seeds.end(),
+             [&deg](int a, int b) { return deg[a] < deg[b]; });
+
+        vector<int> order;
+        order.reserve(n);
+        vector<char> visited(n, 0);
+        vector<int> neighbors;
+        for (int s = 0; s < n; s++) {
+            int seed = seeds[s];
+            if (visited[seed]) continue;
+            visited[seed] = 1;
+            order.push_back(seed);
+            // BFS over this component; 'order' itself is the queue
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                int v = order[head];
+                neighbors.clear();
+                for (long long j = adjPtr[v]; j < adjPtr[v + 1]; j++)
+                    if (!visited[adj[j]]) {
+                        visited[adj[j]] = 1;
+                        neighbors.push_back(adj[j]);
+                    }
+                sort(neighbors.begin(), neighbors.end(),
+                     [&deg](int a, int b) { return deg[a] < deg[b]; });
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+
+        reverse(order.begin(), order.end()); // the "Reverse" in RCM
+
+        vector<int> newOf(n);
+        for (int i = 0; i < n; i++)
+            newOf[order[i]] = i;
+        return newOf;
+    }
+
+    // Relabel rows and columns in place with the same permutation
+    inline void permuteSymmetric(vector<mtx::Entry>& entries, const vector<int>& newOf) {
+        for (size_t i = 0; i < entries.size(); i++) {
+            entries[i].row = newOf[entries[i].row];
+            entries[i].col = newOf[entries[i].col];
+        }
+    }
+
+} // namespace reorder
+
+#endif // REORDER_H
@@ -1,32 +1,253 @@
 #include "ResultsManager.h"
 
+#include <fstream> // binary timing log (-timelog)
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#endif
+
+/*
+    perf_event plumbing (process-wide)
+    ----------------------------------
+    One fd per event, opened once by initHwCounters with inherit=1 so the
+    OpenMP worker threads spawned later are counted too; reading an inherited
+    event sums the live children. Scenario deltas are taken with two reads
+    around the timed loop instead of a reset ioctl (reset does not propagate
+    to inherited children). Stalled-cycles-backend is optional because many
+    CPUs/kernels do not expose it; the other three events are required.
+*/
+static const int HW_NUM_EVENTS = 4;
+enum { HW_CYCLES = 0, HW_INSTRUCTIONS, HW_STALLED, HW_LLC_MISSES };
+static const int HW_CACHELINE = 64; // bytes fetched per LLC miss
+
+static bool hwOpened = false;
+static string hwFailReason = "hardware counters were not initialized";
+static int hwFds[HW_NUM_EVENTS] = { -1, -1, -1, -1 };
+static long long hwStartValues[HW_NUM_EVENTS] = { 0, 0, 0, 0 };
+
+#ifdef __linux__
+static long long hwRead(int fd) {
+    long long value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+        return -1;
+    return value;
+}
+#endif
+
+void ResultsManager::initHwCounters() {
+#ifdef __linux__
+    static const unsigned long long configs[HW_NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+        PERF_COUNT_HW_CACHE_MISSES, // LLC misses: what actually went to DRAM
+    };
+
+    for (int i = 0; i < HW_NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.inherit = 1;        // count the OpenMP threads spawned later
+        attr.exclude_kernel = 1; // unprivileged perf_event typically requires it
+        attr.exclude_hv = 1;
+
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            if (i == HW_STALLED)
+                continue; // optional event, keep the fd at -1
+            hwFailReason = string("perf_event_open failed: ") + strerror(errno);
+            for (int j = 0; j < i; j++)
+                if (hwFds[j] >= 0) { close(hwFds[j]); hwFds[j] = -1; }
+            return;
+        }
+        hwFds[i] = fd;
+    }
+    hwOpened = true;
+#else
+    hwFailReason = "perf_event is only available on Linux";
+#endif
+}
+
+void ResultsManager::startHwCounters() {
+#ifdef __linux__
+    if (!hwOpened) return;
+    for (int i = 0; i < HW_NUM_EVENTS; i++)
+        hwStartValues[i] = hwRead(hwFds[i]);
+#endif
+}
+
+void ResultsManager::stopHwCounters() {
+#ifdef __linux__
+    if (!hwOpened) return;
+    hwCycles = hwRead(hwFds[HW_CYCLES]) - hwStartValues[HW_CYCLES];
+    hwInstructions = hwRead(hwFds[HW_INSTRUCTIONS]) - hwStartValues[HW_INSTRUCTIONS];
+    hwLLCMisses = hwRead(hwFds[HW_LLC_MISSES]) - hwStartValues[HW_LLC_MISSES];
+    hwStalledCycles = (hwFds[HW_STALLED] >= 0)
+        ? hwRead(hwFds[HW_STALLED]) - hwStartValues[HW_STALLED] : -1;
+    hwCountersCollected = true;
+#endif
+}
+
 ResultsManager::~ResultsManager() {
     clear();
 }
 
-void ResultsManager::setInformation(CSRMatrix* csr, string mtxName) {
-    csrMatrix = csr;
-    matrixName = mtxName;
+void ResultsManager::setKernel(const string& kernel) {
+    kernelType = kernel;
+}
+
+void ResultsManager::setFormat(const string& fmt) {
+    format = fmt;
+}
+
+void ResultsManager::setNumaPolicy(const string& policy) {
+    numaPolicy = policy;
+}
+
+void ResultsManager::setPrecision(const string& prec) {
+    precision = prec;
+}
+
+void ResultsManager::setSymmetryMode(const string& mode) {
+    symmetryMode = mode;
+}
+
+void ResultsManager::setDevice(const string& dev) {
+    device = dev;
+}
+
+void ResultsManager::setOperation(const string& op) {
+    operation = op;
+}
+
+void ResultsManager::setNumVectors(int n) {
+    if (n <= 0)
+        throw runtime_error("Number of vectors must be > 0.");
+    numVectors = n;
+}
+
+void ResultsManager::setPrefetchDist(int dist) {
+    if (dist <= 0)
+        throw runtime_error("Prefetch distance must be > 0.");
+    prefetchDist = dist;
+}
+
+void ResultsManager::setTileCols(int cols) {
+    if (cols <= 0)
+        throw runtime_error("Tile width must be > 0.");
+    tileCols = cols;
+}
+
+void ResultsManager::setBlockInfo(int r, int c, double fillRatio) {
+    if (r <= 0 || c <= 0)
+        throw runtime_error("Block dimensions must be > 0.");
+    blockR = r;
+    blockC = c;
+    blockFillRatio = fillRatio;
+}
+
+void ResultsManager::setThreadStats(const vector<double>& busyMs) {
+    if (busyMs.empty())
+        throw runtime_error("Thread busy-time vector is empty.");
+    threadBusyMs = busyMs;
+}
+
+void ResultsManager::setStreamStats(long long blockRows, long long numBlocks,
+                                    double ioWaitMs, double computeMs) {
+    if (blockRows <= 0 || numBlocks <= 0)
+        throw runtime_error("Stream block geometry must be > 0.");
+    streamBlockRows = blockRows;
+    streamNumBlocks = numBlocks;
+    streamIoWaitMs = ioWaitMs;
+    streamComputeMs = computeMs;
+}
+
+void ResultsManager::setMpiStats(int ranks, long long haloElems, double commMs, double computeMs) {
+    if (ranks <= 0)
+        throw runtime_error("MPI rank count must be > 0.");
+    mpiRanks = ranks;
+    mpiHaloElems = haloElems;
+    mpiCommMs = commMs;
+    mpiComputeMs = computeMs;
+}
+
+void ResultsManager::setAutoTune(const string& source, double ms) {
+    if (source != "search" && source != "cache")
+        throw runtime_error("Auto-tune source must be 'search' or 'cache'.");
+    autoTuneSource = source;
+    autoTuneMs = ms;
+}
+
+void ResultsManager::setMatrixProfile(long long emptyRows, long long rowMin, long long rowMax,
+                                      double rowMean, double rowCV, const vector<long long>& histLog2,
+                                      long long bandwidth, double blockFill2x2) {
+    profileSet = true;
+    profileEmptyRows = emptyRows;
+    profileRowMin = rowMin;
+    profileRowMax = rowMax;
+    profileRowMean = rowMean;
+    profileRowCV = rowCV;
+    profileRowHistLog2 = histLog2;
+    profileBandwidth = bandwidth;
+    profileBlockFill = blockFill2x2;
+}
+
+void ResultsManager::setReorderInfo(const string& policy, long long before, long long after) {
+    reorderPolicy = policy;
+    bandwidthBefore = before;
+    bandwidthAfter = after;
 }
 
-void ResultsManager::setInformation(CSRMatrix* csr, int nThreads, const string schedType, int cSize, string mtxName) {
-    csrMatrix = csr;
-    numThreads = nThreads;
-    schedulingType = schedType;
-    chunkSize = cSize;
-    matrixName = mtxName;
+/*
+    Binary timing log (-timelog, process-wide)
+    ------------------------------------------
+    With -I in the tens of thousands, serializing every iteration time as
+    ASCII and parsing it back dominates the harness, so the raw array goes
+    to one shared binary file instead: packed native float64, appended
+    through a megabyte-buffered stream as the durations arrive. Every
+    manager (each sweep scenario has its own) records the [offset, count)
+    window of its appends, and toJSON prints that pointer in place of the
+    all_iteration_times_ms array; numpy.fromfile-style readers get the
+    raw doubles back without any text parsing.
+*/
+// The buffer is declared before the stream so it outlives the stream's
+// flush-on-exit (statics are destroyed in reverse declaration order)
+static vector<char> g_timingLogBuf;
+static ofstream g_timingLog;
+static string g_timingLogPath;
+static long long g_timingLogBytes = 0;
 
-    sequential = false;
+bool ResultsManager::openTimingLog(const string& path) {
+    g_timingLogBuf.resize(1 << 20);
+    g_timingLog.rdbuf()->pubsetbuf(g_timingLogBuf.data(), g_timingLogBuf.size());
+    g_timingLog.open(path.c_str(), ios::binary | ios::trunc);
+    g_timingLogPath = path;
+    g_timingLogBytes = 0;
+    return g_timingLog.is_open();
 }
 
 void ResultsManager::addIterationDuration(double duration) {
+    if (g_timingLog.is_open()) {
+        if (timingOffset < 0) timingOffset = g_timingLogBytes;
+        g_timingLog.write(reinterpret_cast<const char*>(&duration), sizeof(duration));
+        g_timingLogBytes += (long long)sizeof(duration);
+    }
     iterationDurations.push_back(duration);
 }
 
 void ResultsManager::setIterationDurations(const vector<double>& durations) {
     if (durations.empty())
         throw runtime_error("Iteration durations vector is empty.");
-    iterationDurations = durations;
+    iterationDurations.clear();
+    for (size_t i = 0; i < durations.size(); i++)
+        addIterationDuration(durations[i]);
 }
 
 void ResultsManager::setWarmupDuration(double duration) {
@@ -40,42 +261,125 @@ void ResultsManager::setRealTimeMetrics(size_t byteMoved, size_t flopsMoved) {
     flops = flopsMoved;
 }
 
+/*
+    Adaptive measurement (-adaptive)
+    --------------------------------
+    A fixed -I over-runs small matrices and under-runs noisy large ones.
+    The stopping rule instead brackets the true 90th percentile with the
+    order statistics at ranks n*0.9 +- 1.96*sqrt(n*0.9*0.1) — the ~95%
+    binomial confidence interval, no distribution assumed — and lets the
+    timed loop stop as soon as that interval is narrower than the requested
+    fraction of the p90, within the iteration bounds. While the upper rank
+    falls past the largest sample the interval is unresolved and the run
+    must continue.
+*/
+static double p90CIRelHalfwidth(vector<double> samples) {
+    size_t n = samples.size();
+    if (n < 2) return 1e300;
+    sort(samples.begin(), samples.end());
+
+    const double q = 0.9;
+    double center = n * q;
+    double spread = 1.96 * sqrt(n * q * (1.0 - q));
+    if (center + spread > (double)(n - 1))
+        return 1e300; // CI extends beyond the sample range: unresolved
+    long lo = (long)floor(center - spread);
+    if (lo < 0) lo = 0;
+    long hi = (long)ceil(center + spread);
+
+    size_t idx90 = size_t(ceil(q * n)) - 1;
+    if (idx90 >= n) idx90 = n - 1;
+    if (samples[idx90] <= 0.0) return 0.0;
+    return (samples[hi] - samples[lo]) / 2.0 / samples[idx90];
+}
+
+void ResultsManager::configureAdaptive(double relError, int minIters, int maxIters) {
+    if (relError <= 0.0 || relError >= 1.0)
+        throw runtime_error("Adaptive relative error must be in (0, 1).");
+    if (minIters < 2 || maxIters < minIters)
+        throw runtime_error("Adaptive iteration bounds must satisfy 2 <= min <= max.");
+    adaptiveConfigured = true;
+    adaptiveRelError = relError;
+    adaptiveMinIters = minIters;
+    adaptiveMaxIters = maxIters;
+}
+
+bool ResultsManager::needMoreIterations() {
+    int n = (int)iterationDurations.size();
+    if (n < adaptiveMinIters) return true;
+    adaptiveCIHalfwidth = p90CIRelHalfwidth(iterationDurations);
+    adaptiveConverged = (adaptiveCIHalfwidth <= adaptiveRelError);
+    return !adaptiveConverged && n < adaptiveMaxIters;
+}
+
 void ResultsManager::computeAllMetrics() {
-    if (!csrMatrix || csrMatrix->getRows() == 0 || csrMatrix->getCols() == 0) {
+    if (!hasMatrix || matrixRows == 0 || matrixCols == 0) {
         throw runtime_error("CSR matrix is empty or invalid");
     }
 
-    size_t nnz = csrMatrix->getNNZ();
-    size_t rows = csrMatrix->getRows();
-    size_t cols = csrMatrix->getCols();
+    size_t nnz = matrixNnz;
+    size_t rows = matrixRows;
+    size_t cols = matrixCols;
 
-    // Estimate FLOPs and Bytes moved if not collected during execution
+    // Estimate FLOPs and Bytes moved if not collected during execution.
+    // The byte widths follow the actual value/index types of the run.
     if (flops == 0 || bytesMoved == 0) {
-        flops = 2.0 * nnz; 
-        size_t bytesRead = 8 * nnz           // CSR data (double)
-                        + 4 * nnz            // CSR indices (int)
-                        + 4 * (rows + 1)     // CSR indexPointers (int)
-                        + 8 * cols;          // input vector (double)
-        size_t bytesWritten = 8 * rows;      // output vector (double)
-        bytesMoved = bytesRead + bytesWritten; 
-    } 
+        flops = 2.0 * nnz;
+        size_t bytesRead = valueBytes * nnz          // CSR data
+                        + indexBytes * nnz           // CSR indices
+                        + indexBytes * (rows + 1)    // CSR indexPointers
+                        + valueBytes * cols;         // input vector
+        size_t bytesWritten = valueBytes * rows;     // output vector
+        bytesMoved = bytesRead + bytesWritten;
+    }
 
     if (iterationDurations.empty())
         throw runtime_error("No iteration durations recorded. Cannot compute 90th percentile.");
 
     vector<double> sortedDur = iterationDurations;
+
+    // Adaptive runs start cold on purpose, so the leading samples are still
+    // warming caches and the OpenMP pool: drop everything before the first
+    // sample within 20% of the steady state (median of the second half),
+    // capped at a quarter of the samples so a noisy run keeps its data
+    warmupDiscarded = 0;
+    if (adaptiveConfigured && sortedDur.size() >= 4) {
+        vector<double> tail(sortedDur.begin() + sortedDur.size() / 2, sortedDur.end());
+        sort(tail.begin(), tail.end());
+        double steady = tail[tail.size() / 2];
+        size_t cap = sortedDur.size() / 4, cut = 0;
+        while (cut < cap && sortedDur[cut] > steady * 1.2) cut++;
+        warmupDiscarded = (int)cut;
+        sortedDur.erase(sortedDur.begin(), sortedDur.begin() + cut);
+        adaptiveCIHalfwidth = p90CIRelHalfwidth(sortedDur);
+    }
+    statIterations = (int)sortedDur.size();
     sort(sortedDur.begin(), sortedDur.end());
 
     size_t idx90 = size_t(ceil(0.9 * sortedDur.size())) - 1;
     if (idx90 >= sortedDur.size()) idx90 = sortedDur.size() - 1;
+    size_t idx50 = size_t(ceil(0.5 * sortedDur.size())) - 1;
+    size_t idx10 = size_t(ceil(0.1 * sortedDur.size())) - 1;
 
     duration90 = sortedDur[idx90];                  // ms
+    medianMs = sortedDur[idx50];
+    p10Ms = sortedDur[idx10];
+
+    double sum = 0.0;
+    for (size_t i = 0; i < sortedDur.size(); i++) sum += sortedDur[i];
+    meanMs = sum / sortedDur.size();
+    double varSum = 0.0;
+    for (size_t i = 0; i < sortedDur.size(); i++)
+        varSum += (sortedDur[i] - meanMs) * (sortedDur[i] - meanMs);
+    stddevMs = sortedDur.size() > 1 ? sqrt(varSum / (sortedDur.size() - 1)) : 0.0;
+
     double seconds = duration90 / 1000.0;
-    
+
     // Performance (GFLOPS), bandwidth (GB/s), e Arithmetic Intensity (FLOP/byte)
     gflops = flops / seconds / 1e9;
     bandwidthGBps = double(bytesMoved) / (seconds * 1e9);
     arithmeticIntensity = flops / double(bytesMoved);
+    gflopsPerVector = gflops / numVectors; // per-RHS throughput in SpMM mode
 }
 
 void ResultsManager::addError(const string& msg) {
@@ -84,17 +388,36 @@ void ResultsManager::addError(const string& msg) {
     errors.push_back(msg);
 }
 
+void ResultsManager::inheritRunContext(const ResultsManager& src) {
+    for (size_t i = 0; i < src.errors.size(); i++)
+        errors.push_back(src.errors[i]);
+
+    // An -F=auto profile explains the format every scenario below runs in,
+    // so sweep consumers need it in each block too
+    if (src.profileSet) {
+        profileSet = true;
+        profileEmptyRows = src.profileEmptyRows;
+        profileRowMin = src.profileRowMin;
+        profileRowMax = src.profileRowMax;
+        profileRowMean = src.profileRowMean;
+        profileRowCV = src.profileRowCV;
+        profileRowHistLog2 = src.profileRowHistLog2;
+        profileBandwidth = src.profileBandwidth;
+        profileBlockFill = src.profileBlockFill;
+    }
+}
+
 string ResultsManager::toJSON() const {
     stringstream ss;
     ss << "{\n";
 
     // Matrix info
     ss << "  \"matrix\": {\n";
-    if (csrMatrix) { // if the reading of the file failed, then in main->catch we print an empty matrix info and the error
+    if (hasMatrix) { // if the reading of the file failed, then in main->catch we print an empty matrix info and the error
         ss << "    \"name\": \"" << matrixName << "\",\n";
-        ss << "    \"rows\": " << csrMatrix->getRows() << ",\n";
-        ss << "    \"cols\": " << csrMatrix->getCols() << ",\n";
-        ss << "    \"nnz\": " << csrMatrix->getNNZ() << "\n";
+        ss << "    \"rows\": " << matrixRows << ",\n";
+        ss << "    \"cols\": " << matrixCols << ",\n";
+        ss << "    \"nnz\": " << matrixNnz << "\n";
     } else {
         ss << "    \"name\": \"" << matrixName << "\",\n";
         ss << "    \"rows\": 0,\n";
@@ -103,11 +426,55 @@ string ResultsManager::toJSON() const {
     }
     ss << "  },\n";
 
+    // The structure profile of an -F=auto run: what the thresholds saw
+    // before the format below was chosen
+    if (profileSet) {
+        ss << "  \"matrix_profile\": {\n";
+        ss << "    \"row_length_min\": " << profileRowMin << ",\n";
+        ss << "    \"row_length_max\": " << profileRowMax << ",\n";
+        ss << "    \"row_length_mean\": " << profileRowMean << ",\n";
+        ss << "    \"row_length_cv\": " << profileRowCV << ",\n";
+        ss << "    \"empty_rows\": " << profileEmptyRows << ",\n";
+        ss << "    \"row_length_histogram_log2\": [";
+        for (size_t b = 0; b < profileRowHistLog2.size(); b++) {
+            ss << profileRowHistLog2[b];
+            if (b != profileRowHistLog2.size() - 1) ss << ", ";
+        }
+        ss << "],\n";
+        ss << "    \"column_bandwidth\": " << profileBandwidth << ",\n";
+        ss << "    \"block_fill_2x2\": " << profileBlockFill << "\n";
+        ss << "  },\n";
+    }
+
     if (!sequential) {
         ss << "  \"scenario\": {\n";
         ss << "    \"threads\": " << numThreads << ",\n";
         ss << "    \"scheduling_type\": \"" << schedulingType << "\",\n";
-        ss << "    \"chunk_size\": " << chunkSize << "\n";
+        ss << "    \"chunk_size\": " << chunkSize << ",\n";
+        ss << "    \"kernel\": \"" << kernelType << "\",\n";
+        ss << "    \"format\": \"" << format << "\",\n";
+        ss << "    \"numa_policy\": \"" << numaPolicy << "\",\n";
+        ss << "    \"precision\": \"" << precision << "\",\n";
+        ss << "    \"symmetry_mode\": \"" << symmetryMode << "\",\n";
+        ss << "    \"num_vectors\": " << numVectors;
+        if (device != "host") // offloaded runs name the device mode
+            ss << ",\n    \"device\": \"" << device << "\"";
+        if (operation != "normal") // transpose runs name the product
+            ss << ",\n    \"operation\": \"" << operation << "\"";
+        if (tileCols > 0) // column-tiled runs also report their tile width
+            ss << ",\n    \"tile_cols\": " << tileCols;
+        if (prefetchDist > 0) // prefetched runs also report their lookahead
+            ss << ",\n    \"prefetch_distance\": " << prefetchDist;
+        if (blockR > 0) { // BCSR runs also report their tile size and fill-in
+            ss << ",\n    \"block_size\": \"" << blockR << "x" << blockC << "\",\n";
+            ss << "    \"block_fill_ratio\": " << blockFillRatio;
+        }
+        ss << ",\n    \"reorder\": \"" << reorderPolicy << "\"";
+        if (reorderPolicy != "none") { // reordered runs document what the pass bought
+            ss << ",\n    \"bandwidth_before\": " << bandwidthBefore << ",\n";
+            ss << "    \"bandwidth_after\": " << bandwidthAfter;
+        }
+        ss << "\n";
         ss << "  },\n";
     }
 
@@ -115,17 +482,128 @@ string ResultsManager::toJSON() const {
     ss << "    \"duration_ms\": " << duration90 << ",\n";
     ss << "    \"FLOPs\": " << flops << ",\n";
     ss << "    \"GFLOPS\": " << gflops << ",\n";
+    if (numVectors > 1)
+        ss << "    \"GFLOPS_per_vector\": " << gflopsPerVector << ",\n";
     ss << "    \"Bandwidth_GBps\": " << bandwidthGBps << ",\n";
-    ss << "    \"Arithmetic_intensity\": " << arithmeticIntensity << "\n";
+    ss << "    \"Arithmetic_intensity\": " << arithmeticIntensity << ",\n";
+    ss << "    \"mean_ms\": " << meanMs << ",\n";
+    ss << "    \"median_ms\": " << medianMs << ",\n";
+    ss << "    \"p10_ms\": " << p10Ms << ",\n";
+    ss << "    \"stddev_ms\": " << stddevMs << ",\n";
+    ss << "    \"iterations_measured\": " << statIterations << "\n";
     ss << "  },\n";
+
+    // Adaptive runs document their stopping rule: how narrow the p90's CI
+    // was asked to be, what it reached (-1 = wider than the sample range),
+    // and how many cold leading samples were dropped
+    if (adaptiveConfigured) {
+        ss << "  \"adaptive\": {\n";
+        ss << "    \"target_rel_error\": " << adaptiveRelError << ",\n";
+        ss << "    \"ci_rel_halfwidth\": " << (adaptiveCIHalfwidth < 1e299 ? adaptiveCIHalfwidth : -1.0) << ",\n";
+        ss << "    \"converged\": " << (adaptiveConverged ? "true" : "false") << ",\n";
+        ss << "    \"warmup_iterations_discarded\": " << warmupDiscarded << "\n";
+        ss << "  },\n";
+    }
+
+    // Measured counters next to the modeled traffic: the model charges every
+    // access as a miss, so measured << modeled means the matrix fits in cache
+    if (!sequential) {
+        ss << "  \"hw_counters\": {\n";
+        if (hwCountersCollected) {
+            size_t iters = iterationDurations.empty() ? 1 : iterationDurations.size();
+            ss << "    \"available\": true,\n";
+            ss << "    \"cycles\": " << hwCycles << ",\n";
+            ss << "    \"instructions\": " << hwInstructions << ",\n";
+            ss << "    \"ipc\": " << (hwCycles > 0 ? (double)hwInstructions / hwCycles : 0.0) << ",\n";
+            if (hwStalledCycles >= 0)
+                ss << "    \"stalled_cycles_backend\": " << hwStalledCycles << ",\n";
+            ss << "    \"llc_misses\": " << hwLLCMisses << ",\n";
+            ss << "    \"dram_bytes_measured_per_iteration\": " << (double)hwLLCMisses * HW_CACHELINE / iters << ",\n";
+            ss << "    \"bytes_modeled_per_iteration\": " << bytesMoved << "\n";
+        } else {
+            ss << "    \"available\": false,\n";
+            ss << "    \"reason\": \"" << hwFailReason << "\"\n";
+        }
+        ss << "  },\n";
+    }
+
+    // Streaming runs report how well the prefetch hid the disk: io_wait is
+    // the time the compute loop spent waiting for the next block to be ready
+    if (streamBlockRows > 0) {
+        double total = streamIoWaitMs + streamComputeMs;
+        ss << "  \"stream\": {\n";
+        ss << "    \"block_rows\": " << streamBlockRows << ",\n";
+        ss << "    \"blocks\": " << streamNumBlocks << ",\n";
+        ss << "    \"compute_ms\": " << streamComputeMs << ",\n";
+        ss << "    \"io_wait_ms\": " << streamIoWaitMs << ",\n";
+        ss << "    \"overlap_efficiency\": " << (total > 0.0 ? streamComputeMs / total : 0.0) << "\n";
+        ss << "  },\n";
+    }
+
+    // Distributed runs report the halo volume and the slowest rank's
+    // comm/compute split: a growing comm_fraction is the scaling ceiling
+    if (mpiRanks > 0) {
+        double total = mpiCommMs + mpiComputeMs;
+        ss << "  \"mpi\": {\n";
+        ss << "    \"ranks\": " << mpiRanks << ",\n";
+        ss << "    \"halo_elements_per_iteration\": " << mpiHaloElems << ",\n";
+        ss << "    \"comm_ms\": " << mpiCommMs << ",\n";
+        ss << "    \"compute_ms\": " << mpiComputeMs << ",\n";
+        ss << "    \"comm_fraction\": " << (total > 0.0 ? mpiCommMs / total : 0.0) << "\n";
+        ss << "  },\n";
+    }
+
+    // Auto-tuned runs say where the scenario came from and what finding it
+    // cost; "cache" runs paid only a file lookup
+    if (!autoTuneSource.empty()) {
+        ss << "  \"auto_tune\": {\n";
+        ss << "    \"source\": \"" << autoTuneSource << "\",\n";
+        ss << "    \"tuning_ms\": " << autoTuneMs << "\n";
+        ss << "  },\n";
+    }
+
+    // Per-thread busy times from the instrumented kernel: a high imbalance
+    // points at the schedule, a low one at bandwidth saturation
+    if (!threadBusyMs.empty()) {
+        double maxMs = 0.0, sumMs = 0.0;
+        for (size_t t = 0; t < threadBusyMs.size(); t++) {
+            if (threadBusyMs[t] > maxMs) maxMs = threadBusyMs[t];
+            sumMs += threadBusyMs[t];
+        }
+        double meanMs = sumMs / threadBusyMs.size();
+
+        ss << "  \"thread_stats\": {\n";
+        ss << "    \"busy_ms_per_thread\": [";
+        for (size_t t = 0; t < threadBusyMs.size(); t++) {
+            ss << threadBusyMs[t];
+            if (t != threadBusyMs.size() - 1) ss << ", ";
+        }
+        ss << "],\n";
+        ss << "    \"max_busy_ms\": " << maxMs << ",\n";
+        ss << "    \"mean_busy_ms\": " << meanMs << ",\n";
+        ss << "    \"imbalance\": " << (meanMs > 0.0 ? maxMs / meanMs : 0.0) << ",\n";
+        ss << "    \"idle_fraction\": " << (maxMs > 0.0 ? 1.0 - meanMs / maxMs : 0.0) << "\n";
+        ss << "  },\n";
+    }
     ss << "  \"warmUp_time_ms\": " << warmupDuration << ",\n";
 
-    ss << "  \"all_iteration_times_ms\": [";
-    for (size_t i = 0; i < iterationDurations.size(); i++) {
-        ss << iterationDurations[i];
-        if (i != iterationDurations.size() - 1) ss << ", ";
+    // With the binary timing log the raw array lives on disk; the JSON keeps
+    // only a pointer to this run's window of it
+    if (timingOffset >= 0) {
+        ss << "  \"iteration_times_log\": {\n";
+        ss << "    \"file\": \"" << g_timingLogPath << "\",\n";
+        ss << "    \"offset_bytes\": " << timingOffset << ",\n";
+        ss << "    \"count\": " << iterationDurations.size() << ",\n";
+        ss << "    \"element\": \"float64\"\n";
+        ss << "  },\n";
+    } else {
+        ss << "  \"all_iteration_times_ms\": [";
+        for (size_t i = 0; i < iterationDurations.size(); i++) {
+            ss << iterationDurations[i];
+            if (i != iterationDurations.size() - 1) ss << ", ";
+        }
+        ss << "],\n";
     }
-    ss << "],\n";
 
     // Errors
     ss << "  \"errors\": [";
@@ -143,6 +621,18 @@ void ResultsManager::clear() {
     iterationDurations.clear();
     errors.clear();
     warmupDuration = 0.0;
+    threadBusyMs.clear();
+    hwCountersCollected = false;
+    mpiRanks = 0;
+    autoTuneSource.clear();
+    profileSet = false;
+    profileRowHistLog2.clear();
+    timingOffset = -1;
+    adaptiveConfigured = false;
+    adaptiveConverged = false;
+    adaptiveCIHalfwidth = 0.0;
+    warmupDiscarded = 0;
+    statIterations = 0;
     duration90 = 0.0;
     flops = 0.0;
     gflops = 0.0;
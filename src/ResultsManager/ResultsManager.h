@@ -30,10 +30,12 @@
         },
         "statistics90": {
             "duration_ms": <double>,         // 90th percentile iteration time
-            "FLOPs": <double>,               // total operations 
+            "FLOPs": <double>,               // total operations
             "GFLOP/s": <double>,             // FLOP / time
             "Bandwidth_GB/s": <double>       // total bytes / time
             "arithmetic_intensity": <double> // FLOPs / total bytes
+            "mean_ms" / "median_ms" / "p10_ms" / "stddev_ms": <double>,
+            "iterations_measured": <int>     // samples behind the statistics
         },
         "warmUp_time_ms": <double>,
         "all_iteration_times_ms": [ <double>, <double>, ... ]
@@ -73,38 +75,199 @@
 #include <algorithm>
 #include <cmath> // ceil
 #include <stdexcept>
-#include "CSR/CSRMatrix.h"
 
 using namespace std;
 
 class ResultsManager {
 private:
-    CSRMatrix* csrMatrix = nullptr; // pointer to the CSR matrix
+    // Matrix metadata, captured from any CSRMatrixT instantiation. Keeping
+    // plain numbers here (instead of a matrix pointer) lets one manager class
+    // serve every value/index type combination.
+    bool hasMatrix = false;
+    long long matrixRows = 0, matrixCols = 0, matrixNnz = 0;
+    int valueBytes = 8; // sizeof the matrix value type (8 = fp64, 4 = fp32)
+    int indexBytes = 4; // sizeof the matrix index type
+
     int numThreads = 0;
     string schedulingType;
     int chunkSize = 0;
+    string kernelType = "scalar"; // which SpMV kernel ran (scalar, avx2, avx512...)
+    string format = "csr";        // matrix storage format (csr, sell)
+    string numaPolicy = "none";   // NUMA placement used (none, firsttouch, interleave)
+    string precision = "fp64";    // value precision of this run (fp64, fp32)
+    string symmetryMode = "expand"; // how symmetric files were stored (expand, half)
+    string device = "host";       // where the kernel ran (host, gpu)
+    string operation = "normal";  // the product computed (normal = A x, transpose = A^T x)
+    int numVectors = 1;           // right-hand-side vectors (>1 = SpMM mode)
+    int tileCols = 0;             // -K=tiled column tile width (0 = not tiled)
+    int prefetchDist = 0;         // -K=prefetch lookahead in nonzeros (0 = no prefetch)
+    int blockR = 0, blockC = 0;   // BCSR tile dimensions (0 = not a blocked run)
+    double blockFillRatio = 0.0;  // BCSR stored values / logical nonzeros
+    string reorderPolicy = "none"; // row/column reordering applied (none, rcm)
+    long long bandwidthBefore = 0, bandwidthAfter = 0; // matrix bandwidth around the reorder pass
     string matrixName;
     bool sequential = true;
 
     double warmupDuration = 0.0;
     vector<double> iterationDurations;
 
+    // This run's [offset, count) window of the process-wide binary timing
+    // log (-timelog); -1 = no log open, times stay inline in the JSON
+    long long timingOffset = -1;
+
+    // Adaptive measurement (-adaptive): the timed loop asks
+    // needMoreIterations after every sample and stops once the 95%
+    // order-statistics CI of the p90 is narrow enough (or the budget runs
+    // out); computeAllMetrics then discards the unconverged leading tail
+    bool adaptiveConfigured = false;
+    double adaptiveRelError = 0.0;  // target relative CI half-width
+    int adaptiveMinIters = 0, adaptiveMaxIters = 0;
+    bool adaptiveConverged = false;
+    double adaptiveCIHalfwidth = 0.0; // achieved, relative to the p90
+    int warmupDiscarded = 0;          // leading samples dropped as warm-up
+
     // Metrics
     double duration90 = 0.0;
+    double meanMs = 0.0, medianMs = 0.0, p10Ms = 0.0, stddevMs = 0.0;
+    int statIterations = 0; // samples behind the statistics (after discard)
     size_t flops = 0;
     size_t bytesMoved = 0;
     double gflops = 0.0;
+    double gflopsPerVector = 0.0; // gflops / numVectors (SpMM mode)
     double bandwidthGBps = 0.0;
     double arithmeticIntensity = 0.0;
 
+    // Hardware counters (perf_event), measured over the whole timed loop.
+    // bytesMoved above is a model that assumes every access misses; these are
+    // what the CPU actually did, so the two can be compared per scenario.
+    // Per-thread busy time (ms) over the timed loop, from the instrumented
+    // kernel (-threadstats=on); empty = not collected
+    vector<double> threadBusyMs;
+
+    // Out-of-core streaming (-stream): block geometry and the achieved
+    // disk/compute overlap over the timed loop (0 block rows = not streamed)
+    long long streamBlockRows = 0, streamNumBlocks = 0;
+    double streamIoWaitMs = 0.0, streamComputeMs = 0.0;
+
+    // Distributed runs (spmvMPI): rank count, halo traffic and the
+    // communication/compute split over the timed loop (0 ranks = not MPI)
+    int mpiRanks = 0;
+    long long mpiHaloElems = 0;     // x entries exchanged per iteration, all ranks
+    double mpiCommMs = 0.0;         // slowest rank's halo-exchange time
+    double mpiComputeMs = 0.0;      // slowest rank's local kernel time
+
+    // Structure profile (-F=auto): row-length shape, gather bandwidth and
+    // the cost of a 2x2 blocking, measured before the format was chosen
+    bool profileSet = false;
+    long long profileEmptyRows = 0;
+    long long profileRowMin = 0, profileRowMax = 0;
+    double profileRowMean = 0.0, profileRowCV = 0.0;
+    vector<long long> profileRowHistLog2; // rows with length in [2^k, 2^(k+1))
+    long long profileBandwidth = 0;
+    double profileBlockFill = 0.0;
+
+    // Online auto-tuning (-auto): where the scenario came from ("search" =
+    // probe search this run, "cache" = reused from the config cache) and the
+    // time the search cost (empty source = not auto-tuned)
+    string autoTuneSource;
+    double autoTuneMs = 0.0;
+
+    bool hwCountersCollected = false;
+    long long hwCycles = 0;
+    long long hwInstructions = 0;
+    long long hwStalledCycles = -1; // -1 = event unsupported on this CPU
+    long long hwLLCMisses = 0;
+
     vector<string> errors;
 
 public:
     ResultsManager() = default;
     ~ResultsManager();
 
-    void setInformation(CSRMatrix* csr, int nThreads, const string schedType, int cSize, const string mtxName);   
-    void setInformation(CSRMatrix* csr, const string mtxName); 
+    // Templates over the matrix type so fp32/fp64 and 32/64-bit index
+    // instantiations all record their true element widths for byte accounting
+    template <typename Mat>
+    void setInformation(Mat* csr, int nThreads, const string schedType, int cSize, const string mtxName) {
+        captureMatrix(csr);
+        numThreads = nThreads;
+        schedulingType = schedType;
+        chunkSize = cSize;
+        matrixName = mtxName;
+
+        sequential = false;
+    }
+
+    template <typename Mat>
+    void setInformation(Mat* csr, const string mtxName) {
+        captureMatrix(csr);
+        matrixName = mtxName;
+    }
+
+    // Record which kernel implementation was actually used
+    void setKernel(const string& kernel);
+
+    // Record the matrix storage format (csr, sell)
+    void setFormat(const string& fmt);
+
+    // Record the NUMA placement policy of this run
+    void setNumaPolicy(const string& policy);
+
+    // Record the value precision of this run (fp64, fp32)
+    void setPrecision(const string& prec);
+
+    // Record how symmetric files were stored (expand, half)
+    void setSymmetryMode(const string& mode);
+
+    // Record where the kernel ran (host, gpu)
+    void setDevice(const string& dev);
+
+    // Record the product computed (normal = A x, transpose = A^T x)
+    void setOperation(const string& op);
+
+    // Record the number of right-hand-side vectors (SpMM mode)
+    void setNumVectors(int n);
+
+    // Record the column tile width of a -K=tiled run
+    void setTileCols(int cols);
+
+    // Record the lookahead distance of a -K=prefetch run
+    void setPrefetchDist(int dist);
+
+    // Record the BCSR tile dimensions and fill-in ratio of this run
+    void setBlockInfo(int r, int c, double fillRatio);
+
+    // Record the reordering pass and the bandwidth it achieved
+    void setReorderInfo(const string& policy, long long before, long long after);
+
+    // Hardware counters. initHwCounters opens the perf_event fds once per
+    // process and must run before the OpenMP pool exists (the counters are
+    // inherited by threads spawned afterwards); start/stop bracket the timed
+    // loop and record the deltas into this manager. All three degrade to an
+    // "available": false block in the JSON when perf_event is unavailable.
+    static void initHwCounters();
+    void startHwCounters();
+    void stopHwCounters();
+
+    // Record each thread's busy time (ms) over the timed loop; the imbalance
+    // metrics are derived in toJSON
+    void setThreadStats(const vector<double>& busyMs);
+
+    // Record the streaming block geometry and the io-wait/compute split
+    void setStreamStats(long long blockRows, long long numBlocks,
+                        double ioWaitMs, double computeMs);
+
+    // Record the rank count, halo traffic and comm/compute split of a
+    // distributed run (times are the slowest rank's, which sets the pace)
+    void setMpiStats(int ranks, long long haloElems, double commMs, double computeMs);
+
+    // Record how an -auto run obtained its scenario (search | cache) and
+    // what the tuning cost
+    void setAutoTune(const string& source, double ms);
+
+    // Record the structure profile of an -F=auto run
+    void setMatrixProfile(long long emptyRows, long long rowMin, long long rowMax,
+                          double rowMean, double rowCV, const vector<long long>& histLog2,
+                          long long bandwidth, double blockFill2x2);
 
     // Warm-up
     void setWarmupDuration(double duration);
@@ -112,21 +275,51 @@ public:
     // Real-time metrics during an esecution
     void setRealTimeMetrics(size_t byteMoved, size_t flopsMoved);
 
+    // Open the process-wide binary timing log: from here on every recorded
+    // iteration time is appended to it as packed float64 and toJSON prints a
+    // {file, offset, count} pointer instead of the ASCII array. Returns
+    // false (and leaves times inline) when the file cannot be opened.
+    static bool openTimingLog(const string& path);
+
     // Add iteration durations one by one or set all
     void addIterationDuration(double duration);
     void setIterationDurations(const vector<double>& durations);
 
+    // Adaptive measurement: set the target relative 95% CI half-width of the
+    // p90 and the iteration bounds, then let the timed loop poll
+    // needMoreIterations after every recorded sample
+    void configureAdaptive(double relError, int minIters, int maxIters);
+    bool needMoreIterations();
+
     // Compute all metrics (FLOPs, GFLOPS, Bandwidth, 90th percentile)
     void computeAllMetrics();
 
     // Add error
     void addError(const string& msg);
 
+    // Copy the load/prepare-time diagnostics of the run-wide manager into a
+    // per-scenario one, so every sweep block surfaces the same warnings a
+    // single-run JSON would (fallback notices, load warnings, and the
+    // -F=auto structure profile that justified the format choice)
+    void inheritRunContext(const ResultsManager& src);
+
     // JSON output
     string toJSON() const;
 
     // Clear all stored data
     void clear();
+
+private:
+    template <typename Mat>
+    void captureMatrix(Mat* csr) {
+        hasMatrix = (csr != nullptr);
+        if (!csr) return;
+        matrixRows = (long long)csr->getRows();
+        matrixCols = (long long)csr->getCols();
+        matrixNnz = (long long)csr->getNNZ();
+        valueBytes = (int)sizeof(typename Mat::value_type);
+        indexBytes = (int)sizeof(typename Mat::index_type);
+    }
 };
 
 #endif // RESULTSMANAGER_H
\ No newline at end of file
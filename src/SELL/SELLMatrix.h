@@ -0,0 +1,185 @@
+/*
+    SELLMatrix.h
+
+    This class represents a sparse matrix in SELL-C-sigma format (sliced
+    ELLPACK with row sorting inside sigma-sized windows).
+
+    CSR's row-by-row layout defeats wide SIMD on short-row matrices: each row
+    is a separate reduction of only a handful of elements. SELL-C-sigma packs
+    C consecutive rows into a chunk stored column-major (element j of every
+    row in the chunk is contiguous), so a kernel can process C rows in
+    lockstep with full vector lanes. Rows are sorted by length inside windows
+    of sigma rows before chunking, which keeps rows of similar length together
+    and bounds the zero padding without destroying locality the way a global
+    sort would. A permutation array maps each packed position back to its
+    original row, so vectors keep their natural order.
+
+    Like CSRMatrixT the class is a template over the value and index types and
+    lives entirely in this header; it is built from the same vector<Entry>
+    that readMTX produces.
+*/
+
+#ifndef SELLMATRIX_H
+#define SELLMATRIX_H
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include "CSR/CSRMatrix.h" // csr_index_t, Entry
+
+using namespace std;
+using mtx::Entry;
+
+// Upper bound on C so the kernel can keep its per-chunk accumulators on the
+// stack; plenty for any sensible SIMD width or cache-block height
+static const int SELL_MAX_CHUNK = 64;
+
+template <typename ValueT = double, typename IndexT = csr_index_t>
+class SELLMatrixT {
+private:
+    IndexT rows, cols, nnz;   // logical dimensions (nnz excludes padding)
+    int chunkHeight;          // C: rows packed per chunk
+    int sortWindow;           // sigma: rows sorted by length inside each window
+    IndexT numChunks;
+    IndexT *chunkPtr;         // numChunks+1 offsets into colIdx/val
+    IndexT *chunkLen;         // padded row length of each chunk
+    IndexT *rowPerm;          // packed position -> original row index
+    IndexT *colIdx;           // column-major inside each chunk, padded with 0
+    ValueT *val;              // matching values, padded with 0
+
+public:
+    typedef ValueT value_type;
+    typedef IndexT index_type;
+
+    static string formatName() { return "sell"; }
+
+    SELLMatrixT(int C = 8, int sigma = 256)
+        : rows(0), cols(0), nnz(0), chunkHeight(C), sortWindow(sigma), numChunks(0),
+          chunkPtr(nullptr), chunkLen(nullptr), rowPerm(nullptr), colIdx(nullptr), val(nullptr) {
+        if (C <= 0 || sigma <= 0)
+            throw runtime_error("SELL chunk height and sigma must be > 0.");
+        if (C > SELL_MAX_CHUNK)
+            throw runtime_error("SELL chunk height must be <= " + to_string(SELL_MAX_CHUNK) + ".");
+    }
+
+    ~SELLMatrixT() {
+        clear();
+    }
+
+    // Data accessors
+    IndexT getRows() const { return rows; }
+    IndexT getCols() const { return cols; }
+    IndexT getNNZ() const { return nnz; }
+    int getChunkHeight() const { return chunkHeight; }
+    int getSortWindow() const { return sortWindow; }
+    IndexT getNumChunks() const { return numChunks; }
+    IndexT getPaddedNNZ() const { return numChunks ? chunkPtr[numChunks] : 0; }
+    bool isHalfStored() const { return false; } // only CSR supports -M=half
+    bool isSkewStored() const { return false; }
+
+    // Raw array accessors for the kernel
+    const IndexT* getChunkPtr() const { return chunkPtr; }
+    const IndexT* getChunkLenPtr() const { return chunkLen; }
+    const IndexT* getRowPermPtr() const { return rowPerm; }
+    const IndexT* getColIdxPtr() const { return colIdx; }
+    const ValueT* getValPtr() const { return val; }
+
+    // Free allocated memory and reset the matrix
+    void clear() {
+        delete[] chunkPtr;
+        delete[] chunkLen;
+        delete[] rowPerm;
+        delete[] colIdx;
+        delete[] val;
+        chunkPtr = chunkLen = rowPerm = colIdx = nullptr;
+        val = nullptr;
+        rows = cols = nnz = numChunks = 0;
+    }
+
+    // Build the SELL-C-sigma arrays from coordinate entries. The entries are
+    // first scattered into temporary CSR-style arrays with the same O(nnz)
+    // counting build CSRMatrixT uses, then the rows are length-sorted inside
+    // sigma windows and packed column-major into C-row chunks.
+    void buildFromEntries(const vector<Entry>& entries) {
+        if (entries.empty())
+            throw runtime_error("Cannot build SELL: entries vector is empty.");
+
+        clear();
+
+        nnz = (IndexT)entries.size();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if ((IndexT)entries[i].row >= rows) rows = (IndexT)entries[i].row + 1;
+            if ((IndexT)entries[i].col >= cols) cols = (IndexT)entries[i].col + 1;
+        }
+
+        // Temporary CSR arrays (counting build, accepts entries in any order)
+        vector<IndexT> rowPtr(rows + 1, 0);
+        for (size_t i = 0; i < entries.size(); i++)
+            rowPtr[entries[i].row + 1]++;
+        for (IndexT r = 0; r < rows; r++)
+            rowPtr[r + 1] += rowPtr[r];
+
+        vector<IndexT> csrCol(nnz);
+        vector<ValueT> csrVal(nnz);
+        vector<IndexT> next(rowPtr.begin(), rowPtr.begin() + rows);
+        for (size_t i = 0; i < entries.size(); i++) {
+            IndexT dst = next[entries[i].row]++;
+            csrCol[dst] = (IndexT)entries[i].col;
+            csrVal[dst] = (ValueT)entries[i].value;
+        }
+
+        // Sort rows by descending length inside each sigma window so rows of
+        // similar length share a chunk; stable to keep the original order of
+        // equal-length rows (helps locality on banded matrices)
+        rowPerm = new IndexT[rows];
+        for (IndexT r = 0; r < rows; r++) rowPerm[r] = r;
+        const vector<IndexT>& rp = rowPtr;
+        for (IndexT w = 0; w < rows; w += sortWindow) {
+            IndexT wEnd = (w + sortWindow < rows) ? w + sortWindow : rows;
+            stable_sort(rowPerm + w, rowPerm + wEnd, [&rp](IndexT a, IndexT b) {
+                return (rp[a + 1] - rp[a]) > (rp[b + 1] - rp[b]);
+            });
+        }
+
+        // Chunk lengths: the longest row of each chunk sets its padded width
+        numChunks = (rows + chunkHeight - 1) / chunkHeight;
+        chunkPtr = new IndexT[numChunks + 1];
+        chunkLen = new IndexT[numChunks];
+        chunkPtr[0] = 0;
+        for (IndexT c = 0; c < numChunks; c++) {
+            IndexT maxLen = 0;
+            IndexT pEnd = ((c + 1) * chunkHeight < rows) ? (c + 1) * chunkHeight : rows;
+            for (IndexT p = c * chunkHeight; p < pEnd; p++) {
+                IndexT len = rowPtr[rowPerm[p] + 1] - rowPtr[rowPerm[p]];
+                if (len > maxLen) maxLen = len;
+            }
+            chunkLen[c] = maxLen;
+            chunkPtr[c + 1] = chunkPtr[c] + maxLen * chunkHeight;
+        }
+
+        // Scatter each row into its lane; padding keeps col 0 / value 0 so
+        // the kernel can run the full chunk width without bounds checks
+        IndexT padded = chunkPtr[numChunks];
+        colIdx = new IndexT[padded];
+        val = new ValueT[padded];
+        for (IndexT i = 0; i < padded; i++) { colIdx[i] = 0; val[i] = ValueT(0); }
+
+        for (IndexT p = 0; p < rows; p++) {
+            IndexT r = rowPerm[p];
+            IndexT chunk = p / chunkHeight;
+            IndexT lane = p % chunkHeight;
+            IndexT base = chunkPtr[chunk];
+            IndexT len = rowPtr[r + 1] - rowPtr[r];
+            for (IndexT k = 0; k < len; k++) {
+                colIdx[base + k * chunkHeight + lane] = csrCol[rowPtr[r] + k];
+                val[base + k * chunkHeight + lane] = csrVal[rowPtr[r] + k];
+            }
+        }
+    }
+};
+
+// Default instantiation, mirroring the CSRMatrix alias
+typedef SELLMatrixT<double, csr_index_t> SELLMatrix;
+
+#endif // SELLMATRIX_H
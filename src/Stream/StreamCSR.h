@@ -0,0 +1,237 @@
+/*
+    StreamCSR.h
+
+    Out-of-core streaming SpMV engine (-stream=<rows_per_block>).
+
+    Matrices far larger than RAM cannot be held as in-memory CSR. This engine
+    runs y = Ax directly from the binary sidecar that CSRMatrixT::saveBinary
+    writes: the file is mmap'd, the row range is walked in blocks of a fixed
+    number of rows, and a prefetch thread faults the next blocks' index/value
+    pages into the page cache while the OpenMP team computes the current one.
+    Consumed blocks are released with madvise(MADV_DONTNEED), so the resident
+    set stays at a few blocks regardless of the matrix size.
+
+    The prefetcher runs at most two blocks ahead of the consumer (a bounded
+    producer/consumer pair over the block index), which is what actually
+    overlaps disk latency with compute instead of just reading the whole file
+    up front. The compute thread records how long it waited for each block to
+    become ready; that io-wait time, next to the pure compute time, is the
+    achieved-overlap measurement reported in the results JSON — near-zero
+    io-wait means the disk kept up (or the file was already cached).
+
+    Only the plain CSR layout is streamed; half-stored sidecars are rejected
+    because the symmetric kernel needs random access to the whole of y.
+*/
+
+#ifndef STREAMCSR_H
+#define STREAMCSR_H
+
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <fcntl.h>    // open
+#include <unistd.h>   // close, sysconf
+#include <sys/mman.h> // mmap, madvise
+#include <sys/stat.h> // fstat
+#include "CSR/CSRMatrix.h" // sidecar header constants, csr_index_t
+
+using namespace std;
+
+namespace stream {
+
+    // Milliseconds since an arbitrary epoch, for the overlap accounting
+    inline double nowMs() {
+        return chrono::duration<double, milli>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename ValueT = double, typename IndexT = csr_index_t>
+    class StreamedCSR {
+    private:
+        int fd;
+        size_t mapBytes;
+        unsigned char* base;
+        long long rows, cols, nnz;
+        const IndexT* rowPtr; // rows+1, mmap'd
+        const IndexT* colIdx; // nnz, mmap'd
+        const ValueT* val;    // nnz, mmap'd
+
+        // Fault the pages of [lo, hi) into the page cache by reading one byte
+        // per page; this is the prefetcher's whole job
+        void touchRange(size_t lo, size_t hi) const {
+            static const size_t page = 4096;
+            volatile unsigned char sink = 0;
+            for (size_t off = lo; off < hi; off += page)
+                sink += base[off];
+            (void)sink;
+        }
+
+        // Drop the fully-consumed pages of [lo, hi); the bounds are aligned
+        // inward so pages shared with the neighbouring block survive
+        void releaseRange(size_t lo, size_t hi) const {
+            static const size_t page = 4096;
+            size_t alo = (lo + page - 1) & ~(page - 1);
+            size_t ahi = hi & ~(page - 1);
+            if (ahi > alo)
+                madvise(base + alo, ahi - alo, MADV_DONTNEED);
+        }
+
+        // Byte ranges of a block's column indices and values inside the file
+        // (two disjoint ranges: the arrays are stored back to back, not interleaved)
+        void blockByteRanges(long long entryLo, long long entryHi,
+                             size_t& idxLo, size_t& idxHi,
+                             size_t& valLo, size_t& valHi) const {
+            size_t idxBase = (const unsigned char*)colIdx - base;
+            size_t valBase = (const unsigned char*)val - base;
+            idxLo = idxBase + (size_t)entryLo * sizeof(IndexT);
+            idxHi = idxBase + (size_t)entryHi * sizeof(IndexT);
+            valLo = valBase + (size_t)entryLo * sizeof(ValueT);
+            valHi = valBase + (size_t)entryHi * sizeof(ValueT);
+        }
+
+    public:
+        typedef ValueT value_type;
+        typedef IndexT index_type;
+
+        StreamedCSR() : fd(-1), mapBytes(0), base(nullptr),
+                        rows(0), cols(0), nnz(0),
+                        rowPtr(nullptr), colIdx(nullptr), val(nullptr) {}
+
+        ~StreamedCSR() { close(); }
+
+        long long getRows() const { return rows; }
+        long long getCols() const { return cols; }
+        long long getNNZ() const { return nnz; }
+
+        void close() {
+            if (base) munmap(base, mapBytes);
+            if (fd >= 0) ::close(fd);
+            base = nullptr;
+            fd = -1;
+            mapBytes = 0;
+            rows = cols = nnz = 0;
+        }
+
+        // Map the binary sidecar and validate its header, mirroring the
+        // checks of CSRMatrixT::loadBinary but without reading the arrays
+        void open(const string& binPath) {
+            close();
+
+            fd = ::open(binPath.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw runtime_error("Cannot open binary sidecar for streaming: " + binPath);
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size < (long)(5 * sizeof(int) + 3 * sizeof(long long)))
+                throw runtime_error("Binary sidecar is truncated: " + binPath);
+            mapBytes = (size_t)st.st_size;
+
+            base = (unsigned char*)mmap(nullptr, mapBytes, PROT_READ, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED) {
+                base = nullptr;
+                throw runtime_error("mmap failed on binary sidecar: " + binPath);
+            }
+
+            const int* header = (const int*)base;
+            const long long* dims = (const long long*)(base + 5 * sizeof(int));
+            if (header[0] != CSRBIN_MAGIC || header[1] != CSRBIN_VERSION)
+                throw runtime_error("Unrecognized sidecar format: " + binPath);
+            if (header[2] != (int)sizeof(ValueT) || header[3] != (int)sizeof(IndexT))
+                throw runtime_error("Sidecar value/index widths do not match this build: " + binPath);
+            if (header[4] != 0)
+                throw runtime_error("Half-stored sidecars cannot be streamed (the symmetric kernel needs all of y in memory).");
+
+            rows = dims[0];
+            cols = dims[1];
+            nnz = dims[2];
+
+            size_t need = 5 * sizeof(int) + 3 * sizeof(long long)
+                        + sizeof(IndexT) * (size_t)(rows + 1)
+                        + (sizeof(IndexT) + sizeof(ValueT)) * (size_t)nnz;
+            if (mapBytes < need)
+                throw runtime_error("Binary sidecar is truncated: " + binPath);
+
+            rowPtr = (const IndexT*)(base + 5 * sizeof(int) + 3 * sizeof(long long));
+            colIdx = rowPtr + (rows + 1);
+            val = (const ValueT*)(colIdx + nnz);
+
+            // The row pointers are touched on every pass; keep them resident
+            madvise((void*)rowPtr, sizeof(IndexT) * (size_t)(rows + 1), MADV_WILLNEED);
+        }
+
+        // One full streaming pass y = Ax in row blocks of blockRows, with the
+        // prefetch thread running up to two blocks ahead. Returns the wall
+        // time of the pass (ms) and accumulates the compute and io-wait time
+        // into the given counters.
+        double pass(const ValueT* x, ValueT* y, long long blockRows,
+                    double& ioWaitMs, double& computeMs) const {
+            long long numBlocks = (rows + blockRows - 1) / blockRows;
+
+            long long ready = -1;    // last block faulted in by the prefetcher
+            long long consumed = -1; // last block fully computed and released
+            mutex m;
+            condition_variable cvReady, cvSpace;
+
+            thread prefetcher([&]() {
+                for (long long k = 0; k < numBlocks; k++) {
+                    {
+                        unique_lock<mutex> lock(m);
+                        cvSpace.wait(lock, [&]() { return k <= consumed + 2; });
+                    }
+                    size_t idxLo, idxHi, valLo, valHi;
+                    blockByteRanges(rowPtr[k * blockRows],
+                                    rowPtr[min((k + 1) * blockRows, rows)],
+                                    idxLo, idxHi, valLo, valHi);
+                    touchRange(idxLo, idxHi);
+                    touchRange(valLo, valHi);
+                    {
+                        lock_guard<mutex> lock(m);
+                        ready = k;
+                    }
+                    cvReady.notify_one();
+                }
+            });
+
+            double wallStart = nowMs();
+            for (long long k = 0; k < numBlocks; k++) {
+                double waitStart = nowMs();
+                {
+                    unique_lock<mutex> lock(m);
+                    cvReady.wait(lock, [&]() { return ready >= k; });
+                }
+                double computeStart = nowMs();
+                ioWaitMs += computeStart - waitStart;
+
+                long long rowLo = k * blockRows;
+                long long rowHi = min(rowLo + blockRows, rows);
+                #pragma omp parallel for schedule(runtime)
+                for (long long i = rowLo; i < rowHi; i++) {
+                    ValueT sum = ValueT(0);
+                    for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+                        sum += val[j] * x[colIdx[j]];
+                    y[i] = sum;
+                }
+                computeMs += nowMs() - computeStart;
+
+                // Release the consumed block and let the prefetcher advance
+                size_t idxLo, idxHi, valLo, valHi;
+                blockByteRanges(rowPtr[rowLo], rowPtr[rowHi], idxLo, idxHi, valLo, valHi);
+                releaseRange(idxLo, idxHi);
+                releaseRange(valLo, valHi);
+                {
+                    lock_guard<mutex> lock(m);
+                    consumed = k;
+                }
+                cvSpace.notify_one();
+            }
+            prefetcher.join();
+            return nowMs() - wallStart;
+        }
+    };
+
+} // namespace stream
+
+#endif // STREAMCSR_H
@@ -0,0 +1,117 @@
+/*
+    TiledCSR.h
+
+    Cache-blocked companion structure for the column-tiled kernel (-K=tiled).
+
+    When the column count far exceeds cache capacity, the x[col] gather in
+    the CSR inner loop thrashes: successive rows touch columns spread over
+    the whole vector, so x lines are evicted before they are reused. The
+    companion reorders the nonzeros of an already-built CSRMatrixT by
+    (column tile, row): the kernel then makes one pass per tile, and during
+    a pass only a tileCols-wide segment of x is live, sized to stay resident
+    in L2/LLC. y is accumulated across the tile passes.
+
+    Columns are already sorted within each CSR row, so a row's entries for
+    one tile form a contiguous range; the build is the same O(nnz) counting
+    scatter used everywhere else, keyed by (tile, row). Segment offsets are
+    stored as one flat array indexed by tile*rows + row.
+
+    The companion references the same logical matrix as its source CSR and
+    is rebuilt only when the source arrays or the tile width change (see
+    matches), so sweep scenarios reuse one build.
+*/
+
+#ifndef TILEDCSR_H
+#define TILEDCSR_H
+
+#include <vector>
+#include <stdexcept>
+#include "CSR/CSRMatrix.h" // csr_index_t
+
+using namespace std;
+
+template <typename ValueT = double, typename IndexT = csr_index_t>
+class TiledCSRT {
+private:
+    IndexT rows, numTiles;
+    IndexT tileCols;
+    long long nnz;
+    long long *segPtr;       // numTiles*rows + 1 offsets: segment of (tile, row)
+    IndexT *colIdx;          // nnz, reordered by (tile, row)
+    ValueT *val;             // nnz, reordered by (tile, row)
+    const ValueT *sourceData; // identity of the CSR this was built from
+
+public:
+    TiledCSRT() : rows(0), numTiles(0), tileCols(0), nnz(0),
+                  segPtr(nullptr), colIdx(nullptr), val(nullptr), sourceData(nullptr) {}
+
+    ~TiledCSRT() { clear(); }
+
+    IndexT getRows() const { return rows; }
+    IndexT getNumTiles() const { return numTiles; }
+    IndexT getTileCols() const { return tileCols; }
+    const long long* getSegPtr() const { return segPtr; }
+    const IndexT* getColIdxPtr() const { return colIdx; }
+    const ValueT* getValPtr() const { return val; }
+
+    // True if this companion already represents the given CSR arrays with
+    // the given tile width (NUMA placement swaps the arrays, which rebuilds)
+    bool matches(const ValueT* srcData, IndexT tCols) const {
+        return sourceData == srcData && tileCols == tCols && nnz > 0;
+    }
+
+    void clear() {
+        delete[] segPtr;
+        delete[] colIdx;
+        delete[] val;
+        segPtr = nullptr;
+        colIdx = nullptr;
+        val = nullptr;
+        sourceData = nullptr;
+        rows = numTiles = tileCols = 0;
+        nnz = 0;
+    }
+
+    // Reorder the CSR nonzeros by (column tile, row) with a counting build
+    void buildFromCSR(const CSRMatrixT<ValueT, IndexT>& csr, IndexT tCols) {
+        if (tCols <= 0)
+            throw runtime_error("Tile width must be > 0.");
+
+        clear();
+        rows = csr.getRows();
+        nnz = (long long)csr.getNNZ();
+        tileCols = tCols;
+        numTiles = (csr.getCols() + tCols - 1) / tCols;
+        sourceData = csr.getDataPtr();
+
+        const IndexT* rowPtr = csr.getIndexPointersPtr();
+        const IndexT* srcCol = csr.getIndicesPtr();
+        const ValueT* srcVal = csr.getDataPtr();
+
+        size_t numSegs = (size_t)numTiles * rows;
+        segPtr = new long long[numSegs + 1];
+        for (size_t s = 0; s <= numSegs; s++) segPtr[s] = 0;
+
+        // Pass 1: count the entries of each (tile, row) segment
+        for (IndexT i = 0; i < rows; i++)
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+                segPtr[(size_t)(srcCol[j] / tCols) * rows + i + 1]++;
+        for (size_t s = 0; s < numSegs; s++)
+            segPtr[s + 1] += segPtr[s];
+
+        // Pass 2: scatter; columns stay sorted inside each segment because
+        // they are visited in CSR (sorted) order
+        colIdx = new IndexT[nnz];
+        val = new ValueT[nnz];
+        vector<long long> next(segPtr, segPtr + numSegs);
+        for (IndexT i = 0; i < rows; i++) {
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+                long long dst = next[(size_t)(srcCol[j] / tCols) * rows + i]++;
+                colIdx[dst] = srcCol[j];
+                val[dst] = srcVal[j];
+            }
+        }
+    }
+};
+
+#endif // TILEDCSR_H
@@ -1,31 +1,71 @@
 /*
     Utils.cpp
-    
+
     This source file implements utility functions
 */
 
 #include "Utils.h"
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 namespace utils {
 
-    // Helper: create a static random engine that is initialized only once
-    mt19937& getRandomEngine() {
-        // Static ensures only one instance, seeded once
-        static random_device rd; // hardware seed
-        static mt19937 gen(rd()); 
-        return gen;
+    // Elements per seeding block. The block grid is fixed (independent of
+    // the worker count), so a given seed always produces the same vector.
+    static const long long RAND_BLOCK = 1 << 20;
+
+    // Fill blocks [blockLo, blockHi) of arr; each block gets its own
+    // freshly-seeded engine so blocks can be generated in any order
+    static void fillRandomBlocks(double* arr, long long size, double minVal, double maxVal,
+                                 unsigned long long baseSeed, long long blockLo, long long blockHi) {
+        for (long long b = blockLo; b < blockHi; b++) {
+            mt19937_64 gen(baseSeed + (unsigned long long)b + 1);
+            uniform_real_distribution<double> dist(minVal, maxVal);
+            long long lo = b * RAND_BLOCK;
+            long long hi = min(size, lo + RAND_BLOCK);
+            for (long long i = lo; i < hi; i++)
+                arr[i] = dist(gen);
+        }
     }
 
-    double* generateRandomVector(int size, double minVal, double maxVal) {
+    double* generateRandomVector(long long size, double minVal, double maxVal, long long seed) {
         double* arr = new double[size];
-        std::uniform_real_distribution<double> dist(minVal, maxVal);
-        std::mt19937& gen = getRandomEngine();
 
-        for(int i = 0; i < size; ++i) {
-            arr[i] = dist(gen);
+        // seed >= 0 makes the run reproducible; otherwise take a hardware seed
+        unsigned long long baseSeed;
+        if (seed >= 0) {
+            baseSeed = (unsigned long long)seed;
+        } else {
+            random_device rd;
+            baseSeed = ((unsigned long long)rd() << 32) ^ rd();
+        }
+
+        long long numBlocks = (size + RAND_BLOCK - 1) / RAND_BLOCK;
+        unsigned hw = thread::hardware_concurrency();
+        if (hw == 0) hw = 1;
+        long long numThreads = min<long long>(hw, numBlocks);
+
+        if (numThreads <= 1) {
+            fillRandomBlocks(arr, size, minVal, maxVal, baseSeed, 0, numBlocks);
+            return arr;
+        }
+
+        // Each worker touches one contiguous span of blocks — the same even
+        // row partition the kernels use — so the first touch spreads the
+        // pages across the NUMA nodes the way the kernel will read them
+        vector<thread> workers;
+        long long perThread = (numBlocks + numThreads - 1) / numThreads;
+        for (long long t = 0; t < numThreads; t++) {
+            long long b0 = t * perThread;
+            long long b1 = min(numBlocks, b0 + perThread);
+            if (b0 >= b1) break;
+            workers.emplace_back(fillRandomBlocks, arr, size, minVal, maxVal, baseSeed, b0, b1);
         }
+        for (size_t t = 0; t < workers.size(); t++)
+            workers[t].join();
 
-        return arr; 
+        return arr;
     }
 
-} // namespace utils
\ No newline at end of file
+} // namespace utils
@@ -1,8 +1,8 @@
 /*
     Utils.h
-    
+
     This header file it's meant to be a collection of utility functions
-    
+
 */
 
 #ifndef UTILS_H
@@ -14,10 +14,16 @@ using namespace std;
 
 namespace utils {
 
-    // Generate a random double vector of given size in [minVal, maxVal]
-    // The random engine is initialized only once for consistent randomness
-    double* generateRandomVector(int size, double minVal = 0.0, double maxVal = 1.0);
+    // Generate a random double vector of given size in [minVal, maxVal].
+    // The fill is parallel (std::thread, like the .mtx parser): the vector is
+    // split into fixed-size blocks, each with its own seeded engine, and
+    // every worker fills a contiguous span of blocks — so the pages are
+    // first-touched spread across the threads instead of all landing on one
+    // NUMA node, and the output is identical for any thread count.
+    // Pass seed >= 0 for reproducible runs; the default draws a hardware seed.
+    double* generateRandomVector(long long size, double minVal = 0.0, double maxVal = 1.0,
+                                 long long seed = -1);
 
 } // namespace utils
 
-#endif // UTILS_H
\ No newline at end of file
+#endif // UTILS_H
@@ -0,0 +1,482 @@
+/*
+    SPMV MPI
+
+    Distributed-memory SpMV driver for multi-node runs (MPI + OpenMP hybrid).
+    A single node's memory bandwidth caps the in-memory drivers; this one
+    spreads the matrix row-wise across ranks so every node streams only its
+    own slice, and the aggregate bandwidth scales with the node count.
+
+    DISTRIBUTION
+    ------------
+    Rank 0 loads the matrix (through the usual binary sidecar cache) and
+    hands each rank one contiguous block of rows, with the boundaries placed
+    on the nnz prefix sum — the same balancing rule as -S=nnzbalanced — so
+    every rank streams a comparable number of nonzeros. The input vector x
+    is partitioned evenly by column; each rank owns the x entries matching
+    its column span and computes its own y rows (owner computes).
+
+    HALO EXCHANGE
+    -------------
+    A rank's rows usually reference x entries owned by other ranks. During
+    setup each rank scans its local column indices once and tells every peer
+    exactly which of its x entries it needs — only those values travel, not
+    the whole vector. The local indices are then rewritten to point into a
+    compact vector [owned x | halo x], so the per-rank kernel is the plain
+    OpenMP CSR row loop from the shared-memory driver, untouched. Each timed
+    iteration is one MPI_Alltoallv of the halo values plus the local kernel.
+
+    CLI ARGUMENTS
+    -------------
+      matrix_path         Path to the input .mtx matrix (REQUIRED)
+      -T=<int>            OpenMP threads per rank (default 1)
+      -S=<string>         Scheduling: static | dynamic | guided (default static)
+      -C=<int>            Chunk size for OpenMP scheduling
+      -I=<int>            Number of timed iterations (default 1)
+      -P=<string>         Value precision: fp64 | fp32 (default fp64)
+      -seed=<int>         Seed for the random input vector (>= 0)
+
+    The rank count comes from the launcher, e.g.:
+        mpirun -np 8 bin/spmvMPI matrices/heart1.mtx -T=4 -I=50
+
+    OUTPUT FORMAT (JSON, rank 0 only)
+    ---------------------------------
+    The usual parallel JSON block, where each iteration duration is the
+    slowest rank's wall time for that iteration (ranks are barrier-aligned
+    at the iteration start), plus an "mpi" section:
+        "mpi": {
+            "ranks": <int>,
+            "halo_elements_per_iteration": <int>,  // x values exchanged, all ranks
+            "comm_ms": <double>,                   // slowest rank, timed loop total
+            "compute_ms": <double>,
+            "comm_fraction": <double>              // the scaling ceiling
+        }
+
+    COMPILATION
+    -----------
+        using makefile:
+            make mpi
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm> // upper_bound, lower_bound
+#include <memory>    // unique_ptr
+#include <climits>   // INT_MAX
+
+#include <mpi.h>
+
+// include project headers
+#include "CSR/CSRMatrix.h"
+#include "MTX/MTXReader.h"
+#include "ResultsManager/ResultsManager.h"
+#include "Utils/Utils.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace utils;
+using namespace mtx;
+
+// MPI datatypes matching the project's template parameters
+static MPI_Datatype mpiValueType(double) { return MPI_DOUBLE; }
+static MPI_Datatype mpiValueType(float)  { return MPI_FLOAT; }
+static MPI_Datatype mpiIndexType() {
+    return sizeof(csr_index_t) == 8 ? MPI_LONG_LONG : MPI_INT;
+}
+
+// CLI Options
+struct CLIOptions {
+    string filePath;
+    string schedulingType = "static";
+    int chunkSize = 0;
+    int iterations = 1;
+    int numThreads = 1;        // OpenMP threads per rank
+    string precision = "fp64"; // fp64 | fp32 (matrix and vector value type)
+    long long seed = -1;       // >= 0 = reproducible input vector
+};
+
+CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
+    if (argc < 2) {
+        resultsManager.addError(string(argv[0]) + " requires matrix_path [-T=threads_per_rank] [-S=scheduling] [-C=chunkSize] [-I=iterations]");
+        throw runtime_error("Insufficient CLI arguments");
+    }
+
+    CLIOptions opts;
+    opts.filePath = argv[1];
+
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("-T=", 0) == 0) {
+            int val = stoi(arg.substr(3));
+            if (val <= 0) throw runtime_error("Threads per rank must be > 0");
+            opts.numThreads = val;
+        } else if (arg.rfind("-S=", 0) == 0) {
+            string sval = arg.substr(3);
+            if (sval != "static" && sval != "dynamic" && sval != "guided")
+                throw runtime_error("Invalid scheduling type. Allowed: static, dynamic, guided");
+            opts.schedulingType = sval;
+        } else if (arg.rfind("-C=", 0) == 0) {
+            int val = stoi(arg.substr(3));
+            if (val < 0) throw runtime_error("Chunk size must be >= 0");
+            opts.chunkSize = val;
+        } else if (arg.rfind("-I=", 0) == 0) {
+            int val = stoi(arg.substr(3));
+            if (val <= 0) throw runtime_error("Iterations must be > 0");
+            opts.iterations = val;
+        } else if (arg.rfind("-P=", 0) == 0) {
+            string pval = arg.substr(3);
+            if (pval != "fp64" && pval != "fp32")
+                throw runtime_error("Invalid precision. Allowed: fp64, fp32");
+            opts.precision = pval;
+        } else if (arg.rfind("-seed=", 0) == 0) {
+            long long sval = stoll(arg.substr(6));
+            if (sval < 0) throw runtime_error("seed must be >= 0");
+            opts.seed = sval;
+        } else {
+            resultsManager.addError("Unknown argument: '" + arg + "'");
+            throw runtime_error("Unknown argument");
+        }
+    }
+
+    return opts;
+}
+
+/*
+    One rank's slice of the distributed matrix: a contiguous row block in
+    local CSR form (rowPtr rebased to 0), plus the global geometry every
+    rank needs for partitioning x. Column indices start out global and are
+    rewritten by HaloExchange::setup to address the compact x vector.
+*/
+template <typename ValueT>
+struct LocalBlock {
+    long long globalRows = 0, globalCols = 0, globalNnz = 0;
+    long long rowLo = 0, rowHi = 0;   // this rank's row span [rowLo, rowHi)
+    vector<csr_index_t> rowPtr;       // rowHi - rowLo + 1 entries, rebased
+    vector<csr_index_t> colIdx;       // local nnz, global column indices
+    vector<ValueT> val;               // local nnz
+};
+
+/*
+    Rank 0 loads the matrix, places the row-block boundaries on the nnz
+    prefix sum and sends each rank its slice; the full matrix is freed
+    before the benchmark so rank 0's footprint matches the other ranks'.
+    Single MPI messages carry each array, which caps a rank's slice at
+    INT_MAX elements — the INDEX64 builds that exceed this are expected to
+    use more ranks, not bigger slices.
+*/
+template <typename ValueT>
+static LocalBlock<ValueT> distributeMatrix(const CLIOptions& opts, int rank, int numRanks,
+                                           ResultsManager& resultsManager) {
+    typedef CSRMatrixT<ValueT, csr_index_t> MatT;
+    LocalBlock<ValueT> block;
+
+    long long dims[3] = {0, 0, 0};
+    vector<long long> rowBound(numRanks + 1, 0);
+
+    if (rank == 0) {
+        MatT csr;
+        csr.loadFromMTX(opts.filePath);
+        if (csr.isHalfStored())
+            throw runtime_error("The distributed driver needs the expanded form; rebuild the sidecar without -M=half.");
+
+        string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
+        resultsManager.setInformation(&csr, opts.numThreads, opts.schedulingType, opts.chunkSize, matrixName);
+        resultsManager.setPrecision(opts.precision);
+
+        dims[0] = (long long)csr.getRows();
+        dims[1] = (long long)csr.getCols();
+        dims[2] = (long long)csr.getNNZ();
+
+        // Row-block boundaries on the nnz prefix sum (same rule as the
+        // shared-memory nnzbalanced partition)
+        const csr_index_t* rowPtr = csr.getIndexPointersPtr();
+        rowBound[numRanks] = dims[0];
+        for (int r = 1; r < numRanks; r++) {
+            long long target = dims[2] * r / numRanks;
+            const csr_index_t* pos = upper_bound(rowPtr + 1, rowPtr + dims[0] + 1, (csr_index_t)target);
+            rowBound[r] = (long long)(pos - (rowPtr + 1));
+            if (rowBound[r] > dims[0]) rowBound[r] = dims[0];
+        }
+
+        MPI_Bcast(dims, 3, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+        MPI_Bcast(rowBound.data(), numRanks + 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+        // Ship every rank its slice; keep rank 0's by direct copy
+        const csr_index_t* srcCol = csr.getIndicesPtr();
+        const ValueT* srcVal = csr.getDataPtr();
+        for (int r = numRanks - 1; r >= 0; r--) {
+            long long lo = rowBound[r], hi = rowBound[r + 1];
+            long long nnzLo = (long long)rowPtr[lo], nnzHi = (long long)rowPtr[hi];
+            long long localRows = hi - lo, localNnz = nnzHi - nnzLo;
+            if (localRows + 1 > INT_MAX || localNnz > INT_MAX)
+                throw runtime_error("A rank's slice exceeds INT_MAX elements; use more ranks.");
+
+            vector<csr_index_t> ptr(localRows + 1);
+            for (long long i = 0; i <= localRows; i++)
+                ptr[i] = (csr_index_t)(rowPtr[lo + i] - nnzLo);
+
+            if (r == 0) {
+                block.rowPtr = ptr;
+                block.colIdx.assign(srcCol + nnzLo, srcCol + nnzHi);
+                block.val.assign(srcVal + nnzLo, srcVal + nnzHi);
+            } else {
+                MPI_Send(ptr.data(), (int)(localRows + 1), mpiIndexType(), r, 0, MPI_COMM_WORLD);
+                MPI_Send(const_cast<csr_index_t*>(srcCol) + nnzLo, (int)localNnz, mpiIndexType(), r, 1, MPI_COMM_WORLD);
+                MPI_Send(const_cast<ValueT*>(srcVal) + nnzLo, (int)localNnz, mpiValueType(ValueT()), r, 2, MPI_COMM_WORLD);
+            }
+        }
+        // csr goes out of scope here: rank 0 keeps only its slice
+    } else {
+        MPI_Bcast(dims, 3, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+        MPI_Bcast(rowBound.data(), numRanks + 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+        long long localRows = rowBound[rank + 1] - rowBound[rank];
+        block.rowPtr.resize(localRows + 1);
+        MPI_Recv(block.rowPtr.data(), (int)(localRows + 1), mpiIndexType(), 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        long long localNnz = (long long)block.rowPtr[localRows];
+        block.colIdx.resize(localNnz);
+        block.val.resize(localNnz);
+        MPI_Recv(block.colIdx.data(), (int)localNnz, mpiIndexType(), 0, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Recv(block.val.data(), (int)localNnz, mpiValueType(ValueT()), 0, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+
+    block.globalRows = dims[0];
+    block.globalCols = dims[1];
+    block.globalNnz = dims[2];
+    block.rowLo = rowBound[rank];
+    block.rowHi = rowBound[rank + 1];
+    return block;
+}
+
+/*
+    Halo exchange machinery. setup() runs once: every rank lists the exact
+    x entries it needs from each peer (from its own column indices) and the
+    peers learn, symmetrically, what to pack for it. exchange() runs every
+    iteration and moves only those values with one MPI_Alltoallv. After
+    setup the local column indices address the compact vector
+    [owned x (ownedCount) | halo x (peer order)], which the kernel gathers
+    from like any x.
+*/
+template <typename ValueT>
+struct HaloExchange {
+    long long colLo = 0, colHi = 0;   // this rank's owned x span
+    long long ownedCount = 0;
+    long long haloCount = 0;          // values received per iteration
+    long long globalHalo = 0;         // sum of haloCount over all ranks
+    vector<int> recvCounts, recvDispls; // halo values from each peer
+    vector<int> sendCounts, sendDispls; // owned values packed for each peer
+    vector<csr_index_t> sendIdx;      // local offsets of the values to pack
+    vector<ValueT> sendBuf;
+
+    void setup(LocalBlock<ValueT>& block, int rank, int numRanks) {
+        int P = numRanks;
+        // x ownership: even column split (x is dense, nnz does not apply)
+        vector<long long> colBound(P + 1);
+        for (int r = 0; r <= P; r++)
+            colBound[r] = block.globalCols * r / P;
+        colLo = colBound[rank];
+        colHi = colBound[rank + 1];
+        ownedCount = colHi - colLo;
+
+        // Sorted unique list of the off-rank columns this rank references
+        vector<csr_index_t> needed;
+        for (size_t j = 0; j < block.colIdx.size(); j++) {
+            long long c = (long long)block.colIdx[j];
+            if (c < colLo || c >= colHi) needed.push_back(block.colIdx[j]);
+        }
+        sort(needed.begin(), needed.end());
+        needed.erase(unique(needed.begin(), needed.end()), needed.end());
+        haloCount = (long long)needed.size();
+
+        // Who owns each needed column; counts first, then the index lists
+        recvCounts.assign(P, 0);
+        for (size_t k = 0; k < needed.size(); k++) {
+            int owner = (int)(upper_bound(colBound.begin() + 1, colBound.end(),
+                                          (long long)needed[k]) - (colBound.begin() + 1));
+            recvCounts[owner]++;
+        }
+        sendCounts.assign(P, 0);
+        MPI_Alltoall(recvCounts.data(), 1, MPI_INT, sendCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+        recvDispls.assign(P, 0);
+        sendDispls.assign(P, 0);
+        for (int r = 1; r < P; r++) {
+            recvDispls[r] = recvDispls[r - 1] + recvCounts[r - 1];
+            sendDispls[r] = sendDispls[r - 1] + sendCounts[r - 1];
+        }
+        long long sendTotal = (long long)sendDispls[P - 1] + sendCounts[P - 1];
+
+        sendIdx.resize(sendTotal);
+        MPI_Alltoallv(needed.data(), recvCounts.data(), recvDispls.data(), mpiIndexType(),
+                      sendIdx.data(), sendCounts.data(), sendDispls.data(), mpiIndexType(),
+                      MPI_COMM_WORLD);
+        // The peers asked in global indices; pack from local offsets
+        for (size_t k = 0; k < sendIdx.size(); k++)
+            sendIdx[k] = (csr_index_t)((long long)sendIdx[k] - colLo);
+        sendBuf.resize(sendTotal);
+
+        // Rewrite the local column indices against [owned | halo]. needed is
+        // sorted by owner then index — exactly the alltoallv receive order.
+        for (size_t j = 0; j < block.colIdx.size(); j++) {
+            long long c = (long long)block.colIdx[j];
+            if (c >= colLo && c < colHi) {
+                block.colIdx[j] = (csr_index_t)(c - colLo);
+            } else {
+                size_t pos = lower_bound(needed.begin(), needed.end(), block.colIdx[j]) - needed.begin();
+                block.colIdx[j] = (csr_index_t)(ownedCount + (long long)pos);
+            }
+        }
+
+        MPI_Allreduce(&haloCount, &globalHalo, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    }
+
+    // xCompact is [owned x | halo x]; the owned part is already in place
+    void exchange(ValueT* xCompact) {
+        for (size_t k = 0; k < sendIdx.size(); k++)
+            sendBuf[k] = xCompact[sendIdx[k]];
+        MPI_Alltoallv(sendBuf.data(), sendCounts.data(), sendDispls.data(), mpiValueType(ValueT()),
+                      xCompact + ownedCount, recvCounts.data(), recvDispls.data(), mpiValueType(ValueT()),
+                      MPI_COMM_WORLD);
+    }
+};
+
+// Local SpMV: the shared-memory driver's OpenMP CSR row loop over this
+// rank's rows, gathering from the compact x
+template <typename ValueT>
+static void localSpMV(const LocalBlock<ValueT>& block, const ValueT* x, ValueT* y) {
+    csr_index_t localRows = (csr_index_t)(block.rowHi - block.rowLo);
+    const csr_index_t* rowPtr = block.rowPtr.data();
+    const csr_index_t* colIdx = block.colIdx.data();
+    const ValueT* val = block.val.data();
+
+    #pragma omp parallel for schedule(runtime)
+    for (csr_index_t i = 0; i < localRows; i++) {
+        ValueT sum = ValueT(0);
+        for (csr_index_t j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+            sum += val[j] * x[colIdx[j]];
+        }
+        y[i] = sum;
+    }
+}
+
+// Whole benchmark for one value type: distribute, exchange halos, run,
+// reduce the per-rank timings onto rank 0
+template <typename ValueT>
+static void runBenchmark(const CLIOptions& opts, int rank, int numRanks,
+                         ResultsManager& resultsManager) {
+    LocalBlock<ValueT> block = distributeMatrix<ValueT>(opts, rank, numRanks, resultsManager);
+
+    HaloExchange<ValueT> halo;
+    halo.setup(block, rank, numRanks);
+
+    #ifdef _OPENMP
+    omp_set_num_threads(opts.numThreads);
+    omp_sched_t schedule = omp_sched_static;
+    if (opts.schedulingType == "dynamic") schedule = omp_sched_dynamic;
+    else if (opts.schedulingType == "guided") schedule = omp_sched_guided;
+    omp_set_schedule(schedule, opts.chunkSize);
+    #endif
+
+    // Rank 0 generates the full deterministic x and scatters the owned
+    // spans; each rank's compact vector holds [owned x | halo x]
+    vector<ValueT> xCompact(halo.ownedCount + halo.haloCount);
+    vector<ValueT> y(block.rowHi - block.rowLo, ValueT(0));
+    {
+        vector<int> counts(numRanks), displs(numRanks);
+        for (int r = 0; r < numRanks; r++) {
+            long long lo = block.globalCols * r / numRanks;
+            long long hi = block.globalCols * (r + 1) / numRanks;
+            counts[r] = (int)(hi - lo);
+            displs[r] = (int)lo;
+        }
+        vector<ValueT> fullX;
+        if (rank == 0) {
+            unique_ptr<double[]> randomVector(generateRandomVector(block.globalCols, -1000.0, 1000.0, opts.seed));
+            fullX.resize(block.globalCols);
+            for (long long i = 0; i < block.globalCols; i++) fullX[i] = (ValueT)randomVector[i];
+        }
+        MPI_Scatterv(fullX.data(), counts.data(), displs.data(), mpiValueType(ValueT()),
+                     xCompact.data(), counts[rank], mpiValueType(ValueT()), 0, MPI_COMM_WORLD);
+    }
+
+    // Warm-up: one untimed full iteration; the byte/FLOP model is the same
+    // global CSR accounting as the shared-memory warm-up
+    MPI_Barrier(MPI_COMM_WORLD);
+    double warmStart = MPI_Wtime();
+    halo.exchange(xCompact.data());
+    localSpMV(block, xCompact.data(), y.data());
+    MPI_Barrier(MPI_COMM_WORLD);
+    double warmLocal = (MPI_Wtime() - warmStart) * 1e3;
+    double warmMax = 0.0;
+    MPI_Reduce(&warmLocal, &warmMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        size_t bytesMoved = (size_t)block.globalNnz * (2 * sizeof(ValueT) + sizeof(csr_index_t))
+                          + (size_t)block.globalRows * sizeof(ValueT);
+        resultsManager.setWarmupDuration(warmMax);
+        resultsManager.setRealTimeMetrics(bytesMoved, (size_t)block.globalNnz * 2);
+    }
+
+    // Timed iterations: ranks are aligned at each iteration start, so the
+    // slowest rank's wall time is the iteration's true duration
+    double commTotal = 0.0, computeTotal = 0.0;
+    for (int it = 0; it < opts.iterations; it++) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t0 = MPI_Wtime();
+        halo.exchange(xCompact.data());
+        double t1 = MPI_Wtime();
+        localSpMV(block, xCompact.data(), y.data());
+        double t2 = MPI_Wtime();
+        commTotal += (t1 - t0) * 1e3;
+        computeTotal += (t2 - t1) * 1e3;
+
+        double localMs = (t2 - t0) * 1e3, iterMs = 0.0;
+        MPI_Reduce(&localMs, &iterMs, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0) resultsManager.addIterationDuration(iterMs);
+    }
+
+    // The slowest rank sets the pace on both sides of the split
+    double commMax = 0.0, computeMax = 0.0;
+    MPI_Reduce(&commTotal, &commMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&computeTotal, &computeMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        resultsManager.setMpiStats(numRanks, halo.globalHalo, commMax, computeMax);
+        resultsManager.computeAllMetrics();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int rank = 0, numRanks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    ResultsManager resultsManager;
+
+    try {
+        CLIOptions opts = parseCLI(argc, argv, resultsManager);
+
+        // Dispatch on the value precision; everything below main is templated
+        if (opts.precision == "fp32")
+            runBenchmark<float>(opts, rank, numRanks, resultsManager);
+        else
+            runBenchmark<double>(opts, rank, numRanks, resultsManager);
+
+        // print JSON output (rank 0 speaks for the job)
+        if (rank == 0)
+            cout << resultsManager.toJSON() << endl;
+    }
+    catch (const exception& e) {
+        resultsManager.addError(string("Fatal error: ") + e.what());
+        if (rank == 0)
+            cout << resultsManager.toJSON() << endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    MPI_Finalize();
+    return 0;
+}
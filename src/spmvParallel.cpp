@@ -31,9 +31,72 @@
     -------------
       matrix_path         Path to the input .mtx matrix (REQUIRED)
       -T=<int>            Number of OpenMP threads
-      -S=<string>         Scheduling: static | dynamic | guided
+      -S=<string>         Scheduling: static | dynamic | guided | nnzbalanced
       -C=<int>            Chunk size for OpenMP scheduling
       -I=<int>            Number of timed iterations
+      -adaptive=<float>   Run until the 95% confidence interval of the p90
+                          time is within this fraction of it (e.g. 0.05);
+                          -I becomes the iteration budget cap, cold leading
+                          samples are discarded automatically, and the JSON
+                          gains an "adaptive" block plus
+                          mean/median/p10/stddev statistics
+      -K=<string>         Kernel: scalar | simd (AVX2/AVX-512 picked via CPUID)
+                          | tiled (column-tiled x gather, see TiledCSR.h)
+                          | prefetch (software-prefetched x gather for
+                          scattered matrices the hardware prefetcher loses)
+      -tile=<int>         Columns per tile for -K=tiled (default 32768, i.e.
+                          a 256KB fp64 segment of x per pass)
+      -pfdist=<int>       Nonzeros to look ahead for -K=prefetch (default 16);
+                          recorded in the scenario JSON so sweeps can tune it
+      -F=<string>         Storage format: csr | sell (SELL-C-sigma, lanes of C
+                          rows processed in lockstep) | dcsr (delta-compressed
+                          column indices, decoded on the fly) | bcsr (r x c
+                          dense tiles, one index per tile) | auto (profile the
+                          structure and pick format AND kernel by thresholds;
+                          the profile goes to a "matrix_profile" JSON section
+                          and an explicit -K is overridden)
+      -B=<string>         BCSR tile size: auto | <r>x<c> (e.g. 2x2, 4x4);
+                          only meaningful with -F=bcsr
+      -R=<string>         Row/column reordering: none | rcm (Reverse
+                          Cuthill-McKee, clusters the x gather near the
+                          diagonal; bandwidth before/after goes to the JSON)
+      -N=<string>         NUMA placement: none | firsttouch | interleave
+      -P=<string>         Value precision: fp64 | fp32
+      -M=<string>         Symmetric files: expand | half (keep stored triangle,
+                          use the symmetry-exploiting kernel)
+      -V=<int>            Number of right-hand-side vectors (SpMM mode: the
+                          matrix is streamed once per k results)
+      -seed=<int>         Seed for the random input vector (>= 0); runs with
+                          the same seed get the same vector regardless of the
+                          thread count. Default: a fresh hardware seed
+      -op=<string>        Operation: normal (y = A x) | transpose (y = A^T x
+                          on the same resident CSR arrays, no transposed copy)
+      -D=<string>         Device: host | gpu (OpenMP target offload; the CSR
+                          arrays and x move to the device once, iterations run
+                          there, and y comes back after the last one — build
+                          with "make parallel-offload" for a real GPU,
+                          otherwise the target regions fall back to the host)
+      -stream=<int>       Out-of-core mode: stream the binary sidecar from
+                          disk in row blocks of the given size, prefetching
+                          block k+1 while computing block k (see StreamCSR.h)
+      -threadstats=<s>    on | off (default): measure each thread's busy time
+                          inside the parallel region and report imbalance
+                          metrics in a "thread_stats" JSON section
+      -auto               Auto-tune (threads, sched, chunk) at run time: a
+                          short pruned probe search picks the winner, which
+                          is cached in results/autotune_cache.txt per matrix
+                          and machine for instant reuse on the next launch
+      -sweep=<spec>       Run every (threads, sched, chunk) combination
+                          in-process on one matrix load and print a JSON array,
+                          e.g. -sweep=threads:1,2,4;sched:static,dynamic;chunk:0,64
+      -out=<path>         Stream the JSON result to this file through a
+                          buffered writer instead of stdout; sweep blocks are
+                          written out as each scenario finishes
+      -timelog=<path>     Append the raw per-iteration times to this binary
+                          log (packed float64) and keep only the summary
+                          statistics plus a {file, offset, count} pointer in
+                          the JSON — long -I runs stop bloating the results
+      -bind=<string>      Thread pinning: close | spread (default spread with -N)
 
     Automatically handles:
       - Validation of user input
@@ -53,7 +116,8 @@
         "scenario": {
             "threads": <int>,
             "scheduling_type": <string>,
-            "chunk_size": <int>
+            "chunk_size": <int>,
+            "kernel": <string>
         },
         "statistics90": {
             "duration_ms": <double>,      
@@ -84,10 +148,18 @@
 #include <stdexcept>
 #include <cstdlib> // getenv
 #include <memory>  // unique_ptr
+#include <unistd.h> // gethostname, for the auto-tune cache key
+#include <cmath>    // sqrt, for the structure profile
 
 // include project headers
 #include "CSR/CSRMatrix.h"
+#include "SELL/SELLMatrix.h"
+#include "DCSR/DCSRMatrix.h"
+#include "BCSR/BCSRMatrix.h"
 #include "MTX/MTXReader.h"
+#include "Reorder/Reorder.h"
+#include "Stream/StreamCSR.h"
+#include "Tiled/TiledCSR.h"
 #include "ResultsManager/ResultsManager.h"
 #include "Utils/Utils.h"
 
@@ -95,36 +167,705 @@
 #include <omp.h>
 #endif
 
+#if defined(__x86_64__)
+#include <immintrin.h> // AVX2/AVX-512 gather kernels
+#endif
+
 using namespace std;
 using namespace utils;
 using namespace mtx;
 
-// SpMV function (parallel)
-double* SpMV(const CSRMatrix& csr, const double* x, double& duration, string schedulingType = "static", int chunksize = 0) 
+/*
+    SIMD row kernels
+    ----------------
+    The scalar inner loop cannot be auto-vectorized through the per-element
+    accessors, so these kernels compute one row's dot product explicitly:
+    unaligned loads of the value stream, gathered x elements, FMA accumulate,
+    horizontal reduce, scalar tail. They carry target attributes so the base
+    -O3 build still runs on machines without AVX; the right variant is picked
+    once at startup from CPUID (see detectSimdKernel).
+*/
+#if defined(__x86_64__)
+__attribute__((target("avx2,fma")))
+static double rowDotAVX2(const double* data, const int* idx, int len, const double* x) {
+    __m256d acc = _mm256_setzero_pd();
+    int j = 0;
+    for (; j + 4 <= len; j += 4) {
+        __m128i cols = _mm_loadu_si128((const __m128i*)(idx + j));
+        __m256d xv = _mm256_i32gather_pd(x, cols, 8);
+        __m256d av = _mm256_loadu_pd(data + j);
+        acc = _mm256_fmadd_pd(av, xv, acc);
+    }
+    double buf[4];
+    _mm256_storeu_pd(buf, acc);
+    double sum = buf[0] + buf[1] + buf[2] + buf[3];
+    for (; j < len; j++) sum += data[j] * x[idx[j]]; // scalar tail
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+static double rowDotAVX512(const double* data, const int* idx, int len, const double* x) {
+    __m512d acc = _mm512_setzero_pd();
+    int j = 0;
+    for (; j + 8 <= len; j += 8) {
+        __m256i cols = _mm256_loadu_si256((const __m256i*)(idx + j));
+        __m512d xv = _mm512_i32gather_pd(cols, x, 8);
+        __m512d av = _mm512_loadu_pd(data + j);
+        acc = _mm512_fmadd_pd(av, xv, acc);
+    }
+    double sum = _mm512_reduce_add_pd(acc);
+    for (; j < len; j++) sum += data[j] * x[idx[j]]; // scalar tail
+    return sum;
+}
+#endif // __x86_64__
+
+/*
+    NUMA placement
+    --------------
+    buildFromEntries fills the CSR arrays from the main thread, so on multi-
+    socket machines every page lands on the first thread's node and the kernel
+    pays cross-socket traffic once -T spans more than one socket. These helpers
+    re-materialize the arrays with the pages touched by the worker threads:
+
+      firsttouch  - pages follow the kernel's static row partition, so each
+                    thread reads mostly node-local memory
+      interleave  - 4KB blocks are distributed round-robin over the threads,
+                    spreading bandwidth evenly across nodes
+
+    Both rely on the threads being pinned (OMP_PROC_BIND/OMP_PLACES, set up in
+    main before the OpenMP runtime initializes).
+*/
+static const int NUMA_PAGE = 4096;
+
+// Copy a flat array so that its pages are placed according to 'policy'
+template <typename T>
+static T* numaCopyArray(const T* src, long n, const string& policy) {
+    T* dst = new T[n];
+    if (policy == "interleave") {
+        long perBlock = NUMA_PAGE / (long)sizeof(T);
+        long numBlocks = (n + perBlock - 1) / perBlock;
+        #pragma omp parallel for schedule(static, 1)
+        for (long b = 0; b < numBlocks; b++) {
+            long s = b * perBlock;
+            long e = (s + perBlock < n) ? s + perBlock : n;
+            for (long i = s; i < e; i++) dst[i] = src[i];
+        }
+    } else { // firsttouch: same static partition the kernel uses
+        #pragma omp parallel for schedule(static)
+        for (long i = 0; i < n; i++) dst[i] = src[i];
+    }
+    return dst;
+}
+
+// Re-place the CSR arrays of an already-built matrix.
+// For firsttouch the indices/data pages are copied row-by-row with the
+// kernel's static row partition, so they end up on the node of the thread
+// that will traverse them.
+template <typename MatT>
+static void applyNumaPlacement(MatT& csr, const string& policy) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    IndexT rows = csr.getRows();
+    IndexT nnz = csr.getNNZ();
+    const IndexT* oldPtr = csr.getIndexPointersPtr();
+    const IndexT* oldIdx = csr.getIndicesPtr();
+    const ValueT* oldVal = csr.getDataPtr();
+
+    IndexT* newPtr;
+    IndexT* newIdx = new IndexT[nnz];
+    ValueT* newVal = new ValueT[nnz];
+
+    if (policy == "firsttouch") {
+        newPtr = numaCopyArray(oldPtr, rows + 1, policy);
+        #pragma omp parallel for schedule(static)
+        for (IndexT i = 0; i < rows; i++) {
+            for (IndexT j = oldPtr[i]; j < oldPtr[i+1]; j++) {
+                newIdx[j] = oldIdx[j];
+                newVal[j] = oldVal[j];
+            }
+        }
+    } else {
+        newPtr = numaCopyArray(oldPtr, rows + 1, policy);
+        delete[] newIdx;
+        delete[] newVal;
+        newIdx = numaCopyArray(oldIdx, nnz, policy);
+        newVal = numaCopyArray(oldVal, nnz, policy);
+    }
+
+    csr.replaceArrays(newPtr, newIdx, newVal);
+}
+
+// SELL and DCSR matrices keep their build-time page layout; prepareRun
+// reports the unsupported policy so the scenario JSON shows the pages were
+// not re-placed.
+template <typename ValueT, typename IndexT>
+static void applyNumaPlacement(SELLMatrixT<ValueT, IndexT>&, const string&) {}
+template <typename ValueT, typename IndexT>
+static void applyNumaPlacement(DCSRMatrixT<ValueT, IndexT>&, const string&) {}
+template <typename ValueT, typename IndexT>
+static void applyNumaPlacement(BCSRMatrixT<ValueT, IndexT>&, const string&) {}
+
+/*
+    Nonzero-balanced partition (-S=nnzbalanced)
+    -------------------------------------------
+    The OpenMP schedules partition by rows, so skewed row lengths leave threads
+    idle (static) or pay per-chunk scheduling overhead (dynamic). This scheme
+    splits the nnz range into T equal-work spans once per matrix: each span
+    boundary is located in indexPointers with a binary search, and a row that
+    straddles a boundary is computed piecewise by the threads that share it
+    (merge-path style), with the partial sums combined in a tiny serial fix-up
+    after the parallel region. Iterations then run with zero scheduling
+    overhead and near-perfect nnz balance.
+*/
+static vector<long long> nnzPartEntry; // T+1 entry offsets delimiting each thread's span
+static vector<long long> nnzPartRow;   // first row of each thread's span
+
+template <typename MatT>
+static void buildNnzPartition(const MatT& csr, int numThreads) {
+    typedef typename MatT::index_type IndexT;
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    long long rows = (long long)csr.getRows();
+    long long nnz = (long long)csr.getNNZ();
+
+    nnzPartEntry.assign(numThreads + 1, 0);
+    nnzPartRow.assign(numThreads + 1, 0);
+    nnzPartEntry[numThreads] = nnz;
+    nnzPartRow[numThreads] = rows;
+
+    for (int t = 1; t < numThreads; t++)
+        nnzPartEntry[t] = nnz * t / numThreads;
+
+    for (int t = 0; t <= numThreads; t++) {
+        // first row r with rowPtr[r+1] > entry boundary (handles empty rows)
+        const IndexT* pos = upper_bound(rowPtr + 1, rowPtr + rows + 1, (IndexT)nnzPartEntry[t]);
+        nnzPartRow[t] = (long long)(pos - (rowPtr + 1));
+        if (nnzPartRow[t] > rows) nnzPartRow[t] = rows;
+    }
+}
+
+// nnzbalanced never reaches the SELL/DCSR paths (runScenario falls back to
+// static first), but the calls must still compile for every matrix type.
+template <typename ValueT, typename IndexT>
+static void buildNnzPartition(const SELLMatrixT<ValueT, IndexT>&, int) {}
+template <typename ValueT, typename IndexT>
+static void buildNnzPartition(const DCSRMatrixT<ValueT, IndexT>&, int) {}
+template <typename ValueT, typename IndexT>
+static void buildNnzPartition(const BCSRMatrixT<ValueT, IndexT>&, int) {}
+
+// Resolved once at startup; nullptr means no SIMD support on this CPU
+static double (*rowDotSimd)(const double*, const int*, int, const double*) = nullptr;
+
+// Pick the widest kernel this CPU supports; returns its name for the JSON
+static string detectSimdKernel() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx512f")) {
+        rowDotSimd = rowDotAVX512;
+        return "avx512";
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        rowDotSimd = rowDotAVX2;
+        return "avx2";
+    }
+#endif
+    return "scalar";
+}
+
+// SIMD row kernels exist only for the fp64 / 32-bit-index instantiation;
+// every other type combination reports unavailable and takes the scalar path.
+template <typename ValueT, typename IndexT>
+struct SimdRowDot {
+    static bool available() { return false; }
+    static ValueT dot(const ValueT*, const IndexT*, IndexT, const ValueT*) { return ValueT(0); }
+};
+
+template <>
+struct SimdRowDot<double, int> {
+    static bool available() { return rowDotSimd != nullptr; }
+    static double dot(const double* val, const int* idx, int len, const double* x) {
+        return rowDotSimd(val, idx, len, x);
+    }
+};
+
+// Kernel body for the nnzbalanced schedule: each thread walks its precomputed
+// equal-work span of the nnz range; boundary rows are summed piecewise and
+// merged serially afterwards (at most 2 partials per thread).
+template <typename MatT>
+static void spmvNnzBalanced(const MatT& csr, const typename MatT::value_type* x,
+                            typename MatT::value_type* y, const string& kernelType) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+
+    int numParts = (int)nnzPartEntry.size() - 1;
+    vector<long long> partRow(2 * numParts, -1);
+    vector<ValueT> partSum(2 * numParts, ValueT(0));
+
+    bool useSimd = (kernelType != "scalar" && SimdRowDot<ValueT, IndexT>::available());
+
+    #pragma omp parallel
+    {
+        #ifdef _OPENMP
+        int t = omp_get_thread_num();
+        #else
+        int t = 0;
+        #endif
+        if (t < numParts) {
+            IndexT e = (IndexT)nnzPartEntry[t];
+            IndexT eEnd = (IndexT)nnzPartEntry[t + 1];
+            IndexT r = (IndexT)nnzPartRow[t];
+            int np = 0;
+
+            while (e < eEnd) {
+                IndexT hi = (rowPtr[r + 1] < eEnd) ? rowPtr[r + 1] : eEnd;
+                ValueT sum;
+                if (useSimd) {
+                    sum = SimdRowDot<ValueT, IndexT>::dot(val + e, colIdx + e, hi - e, x);
+                } else {
+                    sum = ValueT(0);
+                    for (IndexT j = e; j < hi; j++) sum += val[j] * x[colIdx[j]];
+                }
+
+                if (e == rowPtr[r] && hi == rowPtr[r + 1]) {
+                    y[r] = sum; // row fully owned by this thread
+                } else {
+                    partRow[2 * t + np] = (long long)r; // row split across threads
+                    partSum[2 * t + np] = sum;
+                    np++;
+                }
+                e = hi;
+                r++;
+            }
+        }
+    }
+
+    // Serial fix-up: combine the pieces of rows split across threads
+    for (int i = 0; i < 2 * numParts; i++)
+        if (partRow[i] >= 0) y[partRow[i]] = ValueT(0);
+    for (int i = 0; i < 2 * numParts; i++)
+        if (partRow[i] >= 0) y[partRow[i]] += partSum[i];
+}
+
+/*
+    SELL-C-sigma kernel (-F=sell)
+    -----------------------------
+    One chunk holds C rows stored column-major, so the lane loop below reads C
+    contiguous values and accumulates C row sums in lockstep; the compiler
+    vectorizes it without gathers being the only packed work, which is where
+    CSR falls flat on short-row matrices. Padding lanes carry value 0 and
+    column 0, so they contribute nothing and need no bounds checks. Results
+    are written back through the row permutation.
+*/
+template <typename ValueT, typename IndexT>
+static void spmvSell(const SELLMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y) {
+    const IndexT* chunkPtr = mat.getChunkPtr();
+    const IndexT* chunkLen = mat.getChunkLenPtr();
+    const IndexT* rowPerm = mat.getRowPermPtr();
+    const IndexT* colIdx = mat.getColIdxPtr();
+    const ValueT* val = mat.getValPtr();
+    int C = mat.getChunkHeight();
+    IndexT rows = mat.getRows();
+
+    #pragma omp parallel for schedule(runtime)
+    for (IndexT c = 0; c < mat.getNumChunks(); c++) {
+        ValueT sum[SELL_MAX_CHUNK];
+        for (int r = 0; r < C; r++) sum[r] = ValueT(0);
+
+        IndexT base = chunkPtr[c];
+        for (IndexT j = 0; j < chunkLen[c]; j++) {
+            const IndexT* cols = colIdx + base + j * C;
+            const ValueT* vals = val + base + j * C;
+            for (int r = 0; r < C; r++)
+                sum[r] += vals[r] * x[cols[r]];
+        }
+
+        IndexT pEnd = ((c + 1) * (IndexT)C < rows) ? (c + 1) * (IndexT)C : rows;
+        for (IndexT p = c * (IndexT)C; p < pEnd; p++)
+            y[rowPerm[p]] = sum[p - c * (IndexT)C];
+    }
+}
+
+/*
+    Multi-vector kernel (-V=k, SpMM)
+    --------------------------------
+    Block iterative solvers multiply the same matrix against many vectors;
+    running the single-vector kernel k times re-streams the whole CSR
+    structure per vector although the matrix is the dominant traffic. Here X
+    and Y are row-major rows x k blocks and each matrix value, once loaded,
+    is broadcast across the k columns of x[col], so the matrix bytes are read
+    once per k results. The contiguous k-wide inner loop also auto-vectorizes
+    where the gather-bound single-vector loop cannot.
+*/
+template <typename MatT>
+static void spmvMulti(const MatT& csr, const typename MatT::value_type* x,
+                      typename MatT::value_type* y, int numVectors) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+
+    #pragma omp parallel for schedule(runtime)
+    for (IndexT i = 0; i < csr.getRows(); i++) {
+        ValueT* yrow = y + (size_t)i * numVectors;
+        for (int c = 0; c < numVectors; c++) yrow[c] = ValueT(0);
+        for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+            ValueT v = val[j];
+            const ValueT* xrow = x + (size_t)colIdx[j] * numVectors;
+            for (int c = 0; c < numVectors; c++)
+                yrow[c] += v * xrow[c];
+        }
+    }
+}
+
+/*
+    Symmetry-exploiting kernel (-M=half)
+    ------------------------------------
+    With only the stored triangle in memory each off-diagonal entry a_ij
+    contributes twice: y_i += a_ij * x_j and y_j += a_ij * x_i (negated for
+    skew-symmetric files). The column-side update races between threads, so
+    every thread accumulates into a private copy of y and the copies are
+    reduced row-wise afterwards. This halves the matrix traffic at the cost
+    of the scratch zero/reduce passes, which pays off once the matrix is much
+    larger than T output vectors.
+*/
+template <typename MatT>
+static void spmvSymmetric(const MatT& csr, const typename MatT::value_type* x,
+                          typename MatT::value_type* y) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+    IndexT rows = csr.getRows();
+    ValueT mirror = csr.isSkewStored() ? ValueT(-1) : ValueT(1);
+
+    #ifdef _OPENMP
+    int numThreads = omp_get_max_threads();
+    #else
+    int numThreads = 1;
+    #endif
+
+    // Per-thread private copies of y, reused across iterations
+    static vector<ValueT> scratch;
+    scratch.resize((size_t)numThreads * rows);
+
+    #pragma omp parallel
+    {
+        #ifdef _OPENMP
+        int t = omp_get_thread_num();
+        #else
+        int t = 0;
+        #endif
+        ValueT* yloc = scratch.data() + (size_t)t * rows;
+        for (IndexT i = 0; i < rows; i++) yloc[i] = ValueT(0);
+
+        #pragma omp for schedule(runtime) nowait
+        for (IndexT i = 0; i < rows; i++) {
+            ValueT xi = x[i];
+            ValueT sum = ValueT(0);
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+                IndexT c = colIdx[j];
+                ValueT v = val[j];
+                sum += v * x[c];
+                if (c != i) yloc[c] += mirror * v * xi; // mirrored contribution
+            }
+            yloc[i] += sum;
+        }
+
+        // Row-wise reduction of the private copies into y
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for (IndexT i = 0; i < rows; i++) {
+            ValueT sum = ValueT(0);
+            for (int tt = 0; tt < numThreads; tt++)
+                sum += scratch[(size_t)tt * rows + i];
+            y[i] = sum;
+        }
+    }
+}
+
+/*
+    Transpose kernel (-op=transpose)
+    --------------------------------
+    y = A^T x on the resident CSR arrays — solvers that need both products
+    per iteration used to load a pre-transposed copy alongside A, doubling
+    memory and startup. Walking CSR by rows turns the transpose product into
+    a scatter: row i contributes val[j] * x[i] to y[colIdx[j]], which races
+    between threads. Like the symmetric kernel, every thread accumulates
+    into a private copy of y (length cols here) and the copies are reduced
+    afterwards; the row partition and schedule(runtime) stay the same as the
+    forward kernel.
+*/
+template <typename MatT>
+static void spmvTranspose(const MatT& csr, const typename MatT::value_type* x,
+                          typename MatT::value_type* y) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+    IndexT rows = csr.getRows();
+    IndexT cols = csr.getCols();
+
+    #ifdef _OPENMP
+    int numThreads = omp_get_max_threads();
+    #else
+    int numThreads = 1;
+    #endif
+
+    // Per-thread private copies of y, reused across iterations
+    static vector<ValueT> scratch;
+    scratch.resize((size_t)numThreads * cols);
+
+    #pragma omp parallel
+    {
+        #ifdef _OPENMP
+        int t = omp_get_thread_num();
+        #else
+        int t = 0;
+        #endif
+        ValueT* yloc = scratch.data() + (size_t)t * cols;
+        for (IndexT i = 0; i < cols; i++) yloc[i] = ValueT(0);
+
+        #pragma omp for schedule(runtime) nowait
+        for (IndexT i = 0; i < rows; i++) {
+            ValueT xi = x[i];
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+                yloc[colIdx[j]] += val[j] * xi;
+        }
+
+        // Row-wise reduction of the private copies into y
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for (IndexT i = 0; i < cols; i++) {
+            ValueT sum = ValueT(0);
+            for (int tt = 0; tt < numThreads; tt++)
+                sum += scratch[(size_t)tt * cols + i];
+            y[i] = sum;
+        }
+    }
+}
+
+/*
+    Column-tiled kernel (-K=tiled)
+    ------------------------------
+    One pass per column tile over the reordered companion structure: during a
+    pass the gather only touches a tileCols-wide segment of x, which stays
+    cache-resident while it is being used; y is accumulated across passes.
+    The companion lives in a per-instantiation static and is rebuilt only
+    when the source CSR arrays or the tile width change, so the sweep
+    scenarios share one build.
+*/
+template <typename ValueT, typename IndexT>
+static TiledCSRT<ValueT, IndexT>& tiledCompanion() {
+    static TiledCSRT<ValueT, IndexT> companion;
+    return companion;
+}
+
+template <typename ValueT, typename IndexT>
+static void buildTiledCompanion(const CSRMatrixT<ValueT, IndexT>& csr, IndexT tileCols) {
+    TiledCSRT<ValueT, IndexT>& companion = tiledCompanion<ValueT, IndexT>();
+    if (!companion.matches(csr.getDataPtr(), tileCols))
+        companion.buildFromCSR(csr, tileCols);
+}
+
+// The tiled kernel never reaches the other formats (runScenario falls back
+// to scalar first), but the call must still compile for every matrix type.
+template <typename ValueT, typename IndexT>
+static void buildTiledCompanion(const SELLMatrixT<ValueT, IndexT>&, IndexT) {}
+template <typename ValueT, typename IndexT>
+static void buildTiledCompanion(const DCSRMatrixT<ValueT, IndexT>&, IndexT) {}
+template <typename ValueT, typename IndexT>
+static void buildTiledCompanion(const BCSRMatrixT<ValueT, IndexT>&, IndexT) {}
+
+template <typename ValueT, typename IndexT>
+static void spmvTiled(const CSRMatrixT<ValueT, IndexT>& csr, const ValueT* x, ValueT* y) {
+    const TiledCSRT<ValueT, IndexT>& companion = tiledCompanion<ValueT, IndexT>();
+    const long long* segPtr = companion.getSegPtr();
+    const IndexT* colIdx = companion.getColIdxPtr();
+    const ValueT* val = companion.getValPtr();
+    IndexT rows = companion.getRows();
+
+    #pragma omp parallel for schedule(static)
+    for (IndexT i = 0; i < rows; i++) y[i] = ValueT(0);
+
+    for (IndexT t = 0; t < companion.getNumTiles(); t++) {
+        const long long* tileSeg = segPtr + (size_t)t * rows;
+        #pragma omp parallel for schedule(runtime)
+        for (IndexT i = 0; i < rows; i++) {
+            ValueT sum = ValueT(0);
+            for (long long j = tileSeg[i]; j < tileSeg[i + 1]; j++)
+                sum += val[j] * x[colIdx[j]];
+            y[i] += sum;
+        }
+    }
+}
+
+/*
+    Software-prefetching row kernel (-K=prefetch)
+    ---------------------------------------------
+    On power-law matrices the x[colIdx[j]] gather jumps unpredictably and the
+    hardware prefetcher cannot follow it, so every load eats a full DRAM
+    latency. This variant issues __builtin_prefetch on the x entry of the
+    nonzero `dist` positions ahead: colIdx itself streams sequentially (the
+    hardware handles that), so the index of the future gather is cheap to
+    read and its x line can be in flight while the current ones are consumed.
+    The lookahead deliberately crosses row boundaries — short rows would
+    otherwise leave no distance to hide the latency in — and is only clipped
+    at the end of the nonzero array. The distance is a per-run tunable
+    (-pfdist): too short hides nothing, too long evicts lines before use.
+*/
+static int prefetchDistance = 16;            // -pfdist, set per scenario in runScenario
+
+template <typename MatT>
+static void spmvPrefetch(const MatT& csr, const typename MatT::value_type* x,
+                         typename MatT::value_type* y) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+    IndexT rows = csr.getRows();
+    long long nnz = (long long)csr.getNNZ();
+    int dist = prefetchDistance;
+
+    #pragma omp parallel for schedule(runtime)
+    for (IndexT i = 0; i < rows; i++) {
+        ValueT sum = ValueT(0);
+        IndexT rowEnd = rowPtr[i + 1];
+        for (IndexT j = rowPtr[i]; j < rowEnd; j++) {
+            if ((long long)j + dist < nnz)
+                __builtin_prefetch(&x[colIdx[j + dist]], 0, 1);
+            sum += val[j] * x[colIdx[j]];
+        }
+        y[i] = sum;
+    }
+}
+
+/*
+    Instrumented row kernel (-threadstats=on)
+    -----------------------------------------
+    A slow static run can mean load imbalance or bandwidth saturation, and
+    the single omp_get_wtime() pair around the parallel region cannot tell
+    them apart. This variant times each thread's own row span: the nowait
+    clause drops the implicit barrier, so the per-thread stop timestamp
+    excludes the wait for stragglers and the accumulated value is genuine
+    busy time. It is a separate function selected per run; the regular
+    kernels are untouched, so the uninstrumented path pays nothing.
+*/
+static bool threadStatsEnabled = false;      // set per scenario in runScenario
+static vector<double> threadBusySeconds;     // per-thread busy time, summed over the timed loop
+static bool transposeOp = false;             // -op=transpose, set per scenario in runScenario
+
+template <typename MatT>
+static void spmvInstrumented(const MatT& csr, const typename MatT::value_type* x,
+                             typename MatT::value_type* y, const string& kernelType) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+    IndexT rows = csr.getRows();
+    bool useSimd = (kernelType != "scalar" && SimdRowDot<ValueT, IndexT>::available());
+
+    #pragma omp parallel
+    {
+        #ifdef _OPENMP
+        int t = omp_get_thread_num();
+        double tStart = omp_get_wtime();
+        #else
+        int t = 0;
+        double tStart = 0.0;
+        #endif
+
+        #pragma omp for schedule(runtime) nowait
+        for (IndexT i = 0; i < rows; i++) {
+            if (useSimd) {
+                y[i] = SimdRowDot<ValueT, IndexT>::dot(val + rowPtr[i], colIdx + rowPtr[i], rowPtr[i+1] - rowPtr[i], x);
+            } else {
+                ValueT sum = ValueT(0);
+                for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+                    sum += val[j] * x[colIdx[j]];
+                y[i] = sum;
+            }
+        }
+
+        #ifdef _OPENMP
+        threadBusySeconds[t] += omp_get_wtime() - tStart;
+        #else
+        (void)t; (void)tStart;
+        #endif
+    }
+}
+
+// SpMV function (parallel), templated over the matrix instantiation.
+// Writes into the caller-owned buffer y so timed iterations do not allocate.
+template <typename MatT>
+void SpMV(const MatT& csr, const typename MatT::value_type* x, typename MatT::value_type* y,
+          double& duration, string schedulingType = "static", int chunksize = 0, string kernelType = "scalar",
+          int numVectors = 1)
 {
-    double* y = new double[csr.getRows()];
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
     double start = 0.0, end = 0.0;
 
     #ifdef _OPENMP
-    // Set OpenMP scheduling policy
-    omp_sched_t schedule;
-    if (schedulingType == "static") schedule = omp_sched_static;
-    else if (schedulingType == "dynamic") schedule = omp_sched_dynamic;
-    else if (schedulingType == "guided") schedule = omp_sched_guided;
-    else throw runtime_error("Invalid scheduling type: use static, dynamic, or guided.");
+    // Set OpenMP scheduling policy (nnzbalanced bypasses the OpenMP scheduler)
+    if (schedulingType != "nnzbalanced") {
+        omp_sched_t schedule;
+        if (schedulingType == "static") schedule = omp_sched_static;
+        else if (schedulingType == "dynamic") schedule = omp_sched_dynamic;
+        else if (schedulingType == "guided") schedule = omp_sched_guided;
+        else throw runtime_error("Invalid scheduling type: use static, dynamic, guided, or nnzbalanced.");
 
-    omp_set_schedule(schedule, chunksize);
+        omp_set_schedule(schedule, chunksize);
+    }
     start = omp_get_wtime();
     #endif
 
-    // Parallel row-wise SpMV
-    #pragma omp parallel for schedule(runtime)
-    for (int i = 0; i < csr.getRows(); i++) {
-        double sum = 0.0;  // accumulate row sum its private to each thread
-        for (int j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
-            sum += csr.getData(j) * x[csr.getIndices(j)];
+    if (numVectors > 1) {
+        spmvMulti(csr, x, y, numVectors);
+    } else if (csr.isHalfStored()) {
+        spmvSymmetric(csr, x, y);
+    } else if (transposeOp) {
+        spmvTranspose(csr, x, y);
+    } else if (schedulingType == "nnzbalanced") {
+        spmvNnzBalanced(csr, x, y, kernelType);
+    } else if (threadStatsEnabled) {
+        spmvInstrumented(csr, x, y, kernelType);
+    } else if (kernelType == "tiled") {
+        spmvTiled(csr, x, y);
+    } else if (kernelType == "prefetch") {
+        spmvPrefetch(csr, x, y);
+    } else if (kernelType != "scalar" && SimdRowDot<ValueT, IndexT>::available()) {
+        // SIMD path: per-row gather/FMA kernel chosen at startup via CPUID
+        const IndexT* rowPtr = csr.getIndexPointersPtr();
+        const IndexT* colIdx = csr.getIndicesPtr();
+        const ValueT* val = csr.getDataPtr();
+
+        #pragma omp parallel for schedule(runtime)
+        for (IndexT i = 0; i < csr.getRows(); i++) {
+            y[i] = SimdRowDot<ValueT, IndexT>::dot(val + rowPtr[i], colIdx + rowPtr[i], rowPtr[i+1] - rowPtr[i], x);
+        }
+    } else {
+        // Parallel row-wise SpMV (scalar)
+        #pragma omp parallel for schedule(runtime)
+        for (IndexT i = 0; i < csr.getRows(); i++) {
+            ValueT sum = ValueT(0);  // accumulate row sum its private to each thread
+            for (IndexT j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
+                sum += csr.getData(j) * x[csr.getIndices(j)];
+            }
+            y[i] = sum;
         }
-        y[i] = sum;
     }
 
     #ifdef _OPENMP
@@ -132,14 +873,21 @@ double* SpMV(const CSRMatrix& csr, const double* x, double& duration, string sch
     #endif
 
     duration = (end - start) * 1e3; // convert seconds to milliseconds
-    return y;
 }
 
 // SpMV warm-up function (parallel) also used to count bytes moved and flops during warm-up, instead of estimating them.
-void warmUp(const CSRMatrix& csr, const double* x, double& duration, string schedulingType, int chunksize, size_t& bytesMoved, size_t& flopsMoved) {
-    double* y = new double[csr.getRows()];  // output vector
+template <typename MatT>
+void warmUp(const MatT& csr, const typename MatT::value_type* x, typename MatT::value_type* y,
+            double& duration, string schedulingType, int chunksize, size_t& bytesMoved, size_t& flopsMoved,
+            int numVectors = 1) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
     double start = 0.0, end = 0.0;
 
+    // The byte/FLOP counts do not depend on the schedule, so the nnzbalanced
+    // partition just warms up with a plain static schedule
+    if (schedulingType == "nnzbalanced") schedulingType = "static";
+
     bytesMoved = 0;
     flopsMoved = 0;
 
@@ -154,138 +902,1617 @@ void warmUp(const CSRMatrix& csr, const double* x, double& duration, string sche
     start = omp_get_wtime();
     #endif
 
-    #pragma omp parallel for schedule(runtime) reduction(+:bytesMoved, flopsMoved)
-    for (int i = 0; i < csr.getRows(); i++) {
-        double sum = 0.0;
-        for (int j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
-            sum += csr.getData(j) * x[csr.getIndices(j)];
-            bytesMoved += sizeof(double); // csr data
-            bytesMoved += sizeof(int);    // csr indices
-            bytesMoved += sizeof(double); // input vector x
-            flopsMoved += 2;              // 1 mul + 1 add
+    if (numVectors > 1) {
+        // SpMM warm-up: the matrix value and index streams are read once and
+        // amortized over the k columns of x and y.
+        spmvMulti(csr, x, y, numVectors);
+        bytesMoved += (size_t)csr.getNNZ() * (sizeof(ValueT) + sizeof(IndexT));        // csr data + indices
+        bytesMoved += (size_t)csr.getNNZ() * numVectors * sizeof(ValueT);              // gathered x blocks
+        bytesMoved += (size_t)csr.getRows() * numVectors * sizeof(ValueT);             // output blocks
+        flopsMoved += (size_t)csr.getNNZ() * numVectors * 2;                           // mul + add per column
+    } else if (csr.isHalfStored()) {
+        // Half-stored matrices run the symmetric kernel for timing; the
+        // byte/FLOP model is counted analytically since each off-diagonal
+        // entry carries a second x read, y update, mul and add.
+        spmvSymmetric(csr, x, y);
+        for (IndexT i = 0; i < csr.getRows(); i++) {
+            for (IndexT j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
+                bytesMoved += sizeof(ValueT); // csr data
+                bytesMoved += sizeof(IndexT); // csr indices
+                bytesMoved += sizeof(ValueT); // input vector x
+                flopsMoved += 2;              // 1 mul + 1 add
+                if (csr.getIndices(j) != i) {
+                    bytesMoved += 2 * sizeof(ValueT); // mirrored x read + y update
+                    flopsMoved += 2;                  // mirrored mul + add
+                }
+            }
+            bytesMoved += sizeof(ValueT); // output vector y
+        }
+    } else if (transposeOp) {
+        // Transpose warm-up: x is read once per row, the matrix streams as
+        // usual and every entry becomes a scattered y update
+        spmvTranspose(csr, x, y);
+        bytesMoved += (size_t)csr.getNNZ() * (sizeof(ValueT) + sizeof(IndexT)); // csr data + indices
+        bytesMoved += (size_t)csr.getRows() * sizeof(ValueT);                   // input vector x
+        bytesMoved += (size_t)csr.getNNZ() * sizeof(ValueT);                    // scattered y updates
+        bytesMoved += (size_t)csr.getCols() * sizeof(ValueT);                   // output vector y
+        flopsMoved += (size_t)csr.getNNZ() * 2;                                 // 1 mul + 1 add
+    } else {
+        #pragma omp parallel for schedule(runtime) reduction(+:bytesMoved, flopsMoved)
+        for (IndexT i = 0; i < csr.getRows(); i++) {
+            ValueT sum = ValueT(0);
+            for (IndexT j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
+                sum += csr.getData(j) * x[csr.getIndices(j)];
+                bytesMoved += sizeof(ValueT); // csr data
+                bytesMoved += sizeof(IndexT); // csr indices
+                bytesMoved += sizeof(ValueT); // input vector x
+                flopsMoved += 2;              // 1 mul + 1 add
+            }
+            y[i] = sum;
+            bytesMoved += sizeof(ValueT); // output vector y
         }
-        y[i] = sum;
-        bytesMoved += sizeof(double); // output vector y
     }
 
     #ifdef _OPENMP
     end = omp_get_wtime();
     #endif
 
-    delete[] y;
-
     duration = (end - start) * 1e3; // convert ms
 }
 
-// CLI parsing
-struct CLIOptions {
-    string filePath;
-    string schedulingType = "static";
-    int chunkSize = 0;
-    int iterations = 1;
-    int numThreads = 1;
-};
-
-CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
-    if (argc < 2) {
-        resultsManager.addError(string(argv[0]) + " requires matrix_path [-T=num_threads] [-S=scheduling] [-C=chunkSize] [-I=iterations]");
-        throw runtime_error("Insufficient CLI arguments");
-    }
-
-    CLIOptions opts;
-    opts.filePath = argv[1];
+// SpMV overload for SELL-C-sigma matrices; the lane-parallel chunk kernel
+// replaces the per-row kernels, everything else (scheduling, timing) matches
+// the CSR path. kernelType and numVectors are resolved away before this point.
+template <typename ValueT, typename IndexT>
+void SpMV(const SELLMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+          double& duration, string schedulingType = "static", int chunksize = 0,
+          string kernelType = "scalar", int numVectors = 1)
+{
+    (void)kernelType; (void)numVectors;
+    double start = 0.0, end = 0.0;
 
-    // Default threads from OMP_NUM_THREADS or max available
     #ifdef _OPENMP
-    const char* omp_env = getenv("OMP_NUM_THREADS");
-    opts.numThreads = (omp_env) ? max(1, atoi(omp_env)) : omp_get_max_threads();
-    #endif
+    omp_sched_t schedule;
+    if (schedulingType == "static") schedule = omp_sched_static;
+    else if (schedulingType == "dynamic") schedule = omp_sched_dynamic;
+    else if (schedulingType == "guided") schedule = omp_sched_guided;
+    else throw runtime_error("Invalid scheduling type: use static, dynamic, or guided.");
 
-    // Parse additional options
-    for (int i = 2; i < argc; ++i) {
-        string arg = argv[i];
-        int val;
+    omp_set_schedule(schedule, chunksize);
+    start = omp_get_wtime();
+    #endif
 
-        if (arg.rfind("-T=", 0) == 0) {
-            val = stoi(arg.substr(3));
-            if (val <= 0) throw runtime_error("numThreads must be > 0");
-            opts.numThreads = val;
-        } 
-        else if (arg.rfind("-S=", 0) == 0) {
-            string val = arg.substr(3);
-            if (val != "static" && val != "dynamic" && val != "guided")
-                throw runtime_error("Invalid scheduling type. Allowed: static, dynamic, guided");
-            opts.schedulingType = val;
-        } 
-        else if (arg.rfind("-C=", 0) == 0) {
-            val = stoi(arg.substr(3));
-            if (val < 0) throw runtime_error("chunkSize must be >= 0");
-            opts.chunkSize = val;
-        } 
-        else if (arg.rfind("-I=", 0) == 0) {
-            val = stoi(arg.substr(3));
-            if (val <= 0) throw runtime_error("iterations must be > 0");
-            opts.iterations = val;
-        } 
-        else {
-            throw runtime_error("Unknown argument: '" + arg + "'");
-        }
-    }
+    spmvSell(mat, x, y);
 
-    // Cap requested threads to max available, instead of throwing error the execution continues reporting the error
     #ifdef _OPENMP
-        int maxThreads = omp_get_max_threads();
-        if (opts.numThreads > maxThreads) {
-            resultsManager.addError("Requested threads (" + to_string(opts.numThreads) + ") exceeds maximum available (" + to_string(maxThreads) + "). Using max.");
-            opts.numThreads = maxThreads;
-        }
+    end = omp_get_wtime();
     #endif
 
-    return opts;
+    duration = (end - start) * 1e3; // convert seconds to milliseconds
 }
 
-// Main
-int main(int argc, char* argv[]) {
-    ResultsManager resultsManager;
-
-    try {
-        CLIOptions opts = parseCLI(argc, argv, resultsManager);
-        double duration = 0.0;
-
-        #ifdef _OPENMP
-        omp_set_num_threads(opts.numThreads);
-        #endif
+// Warm-up overload for SELL matrices. The kernel really streams the padded
+// entries (padding lanes move bytes and execute FMAs like any other), so the
+// byte/FLOP model counts the padded length, not the logical nnz.
+template <typename ValueT, typename IndexT>
+void warmUp(const SELLMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+            double& duration, string schedulingType, int chunksize,
+            size_t& bytesMoved, size_t& flopsMoved, int numVectors = 1) {
+    (void)numVectors;
+    if (schedulingType == "nnzbalanced") schedulingType = "static";
 
-        // Load matrix
-        CSRMatrix csr;
-        vector<Entry> entries = readMTX(opts.filePath);
-        csr.buildFromEntries(entries);
+    SpMV(mat, x, y, duration, schedulingType, chunksize);
 
-        string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
-        
-        // in order to update the csrMatrix pointer in resultsManager, we need to pass by pointer
-        resultsManager.setInformation(&csr, opts.numThreads, opts.schedulingType, opts.chunkSize, matrixName);
+    size_t padded = (size_t)mat.getPaddedNNZ();
+    bytesMoved = padded * (2 * sizeof(ValueT) + sizeof(IndexT)) // values, gathered x, columns
+               + (size_t)mat.getRows() * sizeof(ValueT);        // output vector y
+    flopsMoved = padded * 2;                                    // 1 mul + 1 add per lane slot
+}
 
-        // Generate input vector
-        unique_ptr<double[]> inputVector(generateRandomVector(csr.getCols(), -1000.0, 1000.0));
-        unique_ptr<double[]> outputVector(nullptr);
+/*
+    Delta-compressed index kernel (-F=dcsr)
+    ---------------------------------------
+    The column stream is decoded on the fly: one byte per entry in the common
+    case, with 16/32-bit escapes for large jumps (see DCSRMatrix.h). Each row
+    has its own byte offset, so the row loop parallelizes exactly like CSR;
+    the decode is a few ALU ops that hide entirely behind the x[] gather on a
+    bandwidth-bound kernel, while the index traffic shrinks up to 4x.
+*/
+template <typename ValueT, typename IndexT>
+static void spmvDcsr(const DCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y) {
+    const IndexT* rowPtr = mat.getRowPtr();
+    const long long* bytePtr = mat.getBytePtr();
+    const unsigned char* stream = mat.getStreamPtr();
+    const ValueT* val = mat.getDataPtr();
 
-        // Warm-up Phase
-        size_t bytesMoved = 0, flopsMoved = 0;
-        warmUp(csr, inputVector.get(), duration, opts.schedulingType, opts.chunkSize, bytesMoved, flopsMoved);
-        resultsManager.setWarmupDuration(duration);
-        resultsManager.setRealTimeMetrics(bytesMoved, flopsMoved);
+    #pragma omp parallel for schedule(runtime)
+    for (IndexT i = 0; i < mat.getRows(); i++) {
+        const unsigned char* p = stream + bytePtr[i];
+        IndexT col = 0;
+        ValueT sum = ValueT(0);
+        for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+            unsigned int b = *p++;
+            if (b < 252) {
+                col += (IndexT)b;
+            } else if (b == 252) {
+                col += (IndexT)(p[0] | ((unsigned int)p[1] << 8));
+                p += 2;
+            } else {
+                col += (IndexT)(p[0] | ((unsigned int)p[1] << 8)
+                              | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24));
+                p += 4;
+            }
+            sum += val[j] * x[col];
+        }
+        y[i] = sum;
+    }
+}
+
+// SpMV overload for delta-compressed matrices; scheduling and timing match
+// the CSR path, the decode-on-the-fly kernel replaces the per-row kernels.
+template <typename ValueT, typename IndexT>
+void SpMV(const DCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+          double& duration, string schedulingType = "static", int chunksize = 0,
+          string kernelType = "scalar", int numVectors = 1)
+{
+    (void)kernelType; (void)numVectors;
+    double start = 0.0, end = 0.0;
+
+    #ifdef _OPENMP
+    omp_sched_t schedule;
+    if (schedulingType == "static") schedule = omp_sched_static;
+    else if (schedulingType == "dynamic") schedule = omp_sched_dynamic;
+    else if (schedulingType == "guided") schedule = omp_sched_guided;
+    else throw runtime_error("Invalid scheduling type: use static, dynamic, or guided.");
+
+    omp_set_schedule(schedule, chunksize);
+    start = omp_get_wtime();
+    #endif
+
+    spmvDcsr(mat, x, y);
+
+    #ifdef _OPENMP
+    end = omp_get_wtime();
+    #endif
+
+    duration = (end - start) * 1e3; // convert seconds to milliseconds
+}
+
+// Warm-up overload for delta-compressed matrices. The index traffic is the
+// actual compressed stream size, which is the whole point of the format.
+template <typename ValueT, typename IndexT>
+void warmUp(const DCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+            double& duration, string schedulingType, int chunksize,
+            size_t& bytesMoved, size_t& flopsMoved, int numVectors = 1) {
+    (void)numVectors;
+    if (schedulingType == "nnzbalanced") schedulingType = "static";
+
+    SpMV(mat, x, y, duration, schedulingType, chunksize);
+
+    bytesMoved = (size_t)mat.getNNZ() * 2 * sizeof(ValueT)  // values + gathered x
+               + (size_t)mat.getStreamBytes()               // compressed column stream
+               + (size_t)mat.getRows() * sizeof(ValueT);    // output vector y
+    flopsMoved = (size_t)mat.getNNZ() * 2;                  // 1 mul + 1 add
+}
+
+/*
+    Block CSR kernel (-F=bcsr)
+    --------------------------
+    One stored tile covers r x c values with a single block column index, so
+    the index traffic per nonzero drops by up to r*c and each loaded x element
+    feeds r accumulators held in registers. The tile loops are instantiated
+    with compile-time dimensions for the supported sizes so the compiler fully
+    unrolls them; right-edge tiles whose padding columns fall outside x take
+    the bounded slow path.
+*/
+template <int R, int C, typename ValueT, typename IndexT>
+static void spmvBcsrFixed(const BCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y) {
+    const IndexT* blockRowPtr = mat.getBlockRowPtr();
+    const IndexT* blockCol = mat.getBlockColPtr();
+    const ValueT* blockVals = mat.getBlockValsPtr();
+    IndexT rows = mat.getRows();
+    IndexT cols = mat.getCols();
+
+    #pragma omp parallel for schedule(runtime)
+    for (IndexT bi = 0; bi < mat.getBlockRows(); bi++) {
+        ValueT sum[R];
+        for (int r = 0; r < R; r++) sum[r] = ValueT(0);
+
+        for (IndexT jb = blockRowPtr[bi]; jb < blockRowPtr[bi + 1]; jb++) {
+            const ValueT* tile = blockVals + (size_t)jb * R * C;
+            IndexT colBase = blockCol[jb] * C;
+            if (colBase + C <= cols) {
+                // Fully-unrolled r x c tile multiply, one x load per column
+                for (int c = 0; c < C; c++) {
+                    ValueT xv = x[colBase + c];
+                    for (int r = 0; r < R; r++)
+                        sum[r] += tile[r * C + c] * xv;
+                }
+            } else {
+                // Right-edge tile: its padding columns have no x element
+                for (int c = 0; colBase + c < cols; c++) {
+                    ValueT xv = x[colBase + c];
+                    for (int r = 0; r < R; r++)
+                        sum[r] += tile[r * C + c] * xv;
+                }
+            }
+        }
+
+        IndexT rowBase = bi * (IndexT)R;
+        IndexT rEnd = (rowBase + R <= rows) ? rowBase + (IndexT)R : rows;
+        for (IndexT i = rowBase; i < rEnd; i++)
+            y[i] = sum[i - rowBase];
+    }
+}
+
+// Dispatch to the unrolled instantiation of the matrix's tile size; the auto
+// selection in buildFromEntries only ever picks from this set.
+template <typename ValueT, typename IndexT>
+static void spmvBcsr(const BCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y) {
+    int r = mat.getBlockR(), c = mat.getBlockC();
+    if (r == 2 && c == 2) spmvBcsrFixed<2, 2>(mat, x, y);
+    else if (r == 4 && c == 4) spmvBcsrFixed<4, 4>(mat, x, y);
+    else if (r == 1 && c == 1) spmvBcsrFixed<1, 1>(mat, x, y);
+    else throw runtime_error("No BCSR kernel for " + to_string(r) + "x" + to_string(c) + " tiles. Allowed: 1x1, 2x2, 4x4.");
+}
+
+// SpMV overload for Block CSR matrices; scheduling and timing match the CSR
+// path, the unrolled tile kernel replaces the per-row kernels.
+template <typename ValueT, typename IndexT>
+void SpMV(const BCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+          double& duration, string schedulingType = "static", int chunksize = 0,
+          string kernelType = "scalar", int numVectors = 1)
+{
+    (void)kernelType; (void)numVectors;
+    double start = 0.0, end = 0.0;
+
+    #ifdef _OPENMP
+    omp_sched_t schedule;
+    if (schedulingType == "static") schedule = omp_sched_static;
+    else if (schedulingType == "dynamic") schedule = omp_sched_dynamic;
+    else if (schedulingType == "guided") schedule = omp_sched_guided;
+    else throw runtime_error("Invalid scheduling type: use static, dynamic, or guided.");
+
+    omp_set_schedule(schedule, chunksize);
+    start = omp_get_wtime();
+    #endif
+
+    spmvBcsr(mat, x, y);
+
+    #ifdef _OPENMP
+    end = omp_get_wtime();
+    #endif
+
+    duration = (end - start) * 1e3; // convert seconds to milliseconds
+}
+
+// Warm-up overload for Block CSR matrices. The kernel really streams the
+// stored tiles (fill-in zeros move bytes and execute FMAs like any other
+// value), so the byte/FLOP model counts blocks x r x c, not the logical nnz;
+// comparing Bandwidth_GBps against a CSR run shows whether the saved index
+// traffic outweighs the fill-in.
+template <typename ValueT, typename IndexT>
+void warmUp(const BCSRMatrixT<ValueT, IndexT>& mat, const ValueT* x, ValueT* y,
+            double& duration, string schedulingType, int chunksize,
+            size_t& bytesMoved, size_t& flopsMoved, int numVectors = 1) {
+    (void)numVectors;
+    if (schedulingType == "nnzbalanced") schedulingType = "static";
+
+    SpMV(mat, x, y, duration, schedulingType, chunksize);
+
+    size_t blocks = (size_t)mat.getNumBlocks();
+    size_t tile = (size_t)mat.getBlockR() * mat.getBlockC();
+    bytesMoved = blocks * tile * sizeof(ValueT)                  // tile values (incl. fill)
+               + blocks * sizeof(IndexT)                         // one column index per tile
+               + blocks * mat.getBlockC() * sizeof(ValueT)       // x elements, reused across tile rows
+               + (size_t)mat.getRows() * sizeof(ValueT);         // output vector y
+    flopsMoved = blocks * tile * 2;                              // 1 mul + 1 add per tile slot
+}
+
+// CLI parsing
+struct CLIOptions {
+    string filePath;
+    string schedulingType = "static";
+    int chunkSize = 0;
+    int iterations = 1;
+    int numThreads = 1;
+    string kernel = "scalar"; // scalar | simd (resolved to avx2/avx512 at runtime)
+    string numaPolicy = "none"; // none | firsttouch | interleave
+    string bindPolicy;          // close | spread (empty = spread when -N is used)
+    string precision = "fp64";  // fp64 | fp32 (matrix and vector value type)
+    string symmetryMode = "expand"; // expand | half (symmetric files only)
+    int numVectors = 1;         // >1 switches to the SpMM multi-vector kernel
+    string sweepSpec;           // non-empty = run every combination in-process
+    string format = "csr";      // csr | sell (storage format and kernel family)
+    string blockSpec = "auto";  // BCSR tile size: auto | <r>x<c>
+    string reorder = "none";    // none | rcm (bandwidth-reducing permutation)
+    bool threadStats = false;   // per-thread busy time + imbalance metrics
+    long long streamBlockRows = 0; // >0 = out-of-core streaming, rows per block
+    int tileCols = 32768;       // columns per tile for -K=tiled (256KB of fp64)
+    int prefetchDist = 16;      // nonzeros of lookahead for -K=prefetch
+    long long seed = -1;        // >= 0 = reproducible input vector
+    string device = "host";     // host | gpu (OpenMP target offload)
+    string operation = "normal"; // normal (y = A x) | transpose (y = A^T x)
+    bool autoTune = false;      // -auto: probe-search the scenario, cache the winner
+    string outPath;             // non-empty = stream the JSON to this file
+    string timelogPath;         // non-empty = binary log for the raw iteration times
+    double adaptiveRelErr = 0.0; // >0 = iterate until the p90's CI is this narrow
+};
 
-        // Actual Timed iterations
+CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
+    if (argc < 2) {
+        resultsManager.addError(string(argv[0]) + " requires matrix_path [-T=num_threads] [-S=scheduling] [-C=chunkSize] [-I=iterations]");
+        throw runtime_error("Insufficient CLI arguments");
+    }
+
+    CLIOptions opts;
+    opts.filePath = argv[1];
+
+    // Default threads from OMP_NUM_THREADS or max available
+    #ifdef _OPENMP
+    const char* omp_env = getenv("OMP_NUM_THREADS");
+    opts.numThreads = (omp_env) ? max(1, atoi(omp_env)) : omp_get_max_threads();
+    #endif
+
+    // Parse additional options
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        int val;
+
+        if (arg.rfind("-T=", 0) == 0) {
+            val = stoi(arg.substr(3));
+            if (val <= 0) throw runtime_error("numThreads must be > 0");
+            opts.numThreads = val;
+        } 
+        else if (arg.rfind("-S=", 0) == 0) {
+            string val = arg.substr(3);
+            if (val != "static" && val != "dynamic" && val != "guided" && val != "nnzbalanced")
+                throw runtime_error("Invalid scheduling type. Allowed: static, dynamic, guided, nnzbalanced");
+            opts.schedulingType = val;
+        }
+        else if (arg.rfind("-C=", 0) == 0) {
+            val = stoi(arg.substr(3));
+            if (val < 0) throw runtime_error("chunkSize must be >= 0");
+            opts.chunkSize = val;
+        } 
+        else if (arg.rfind("-I=", 0) == 0) {
+            val = stoi(arg.substr(3));
+            if (val <= 0) throw runtime_error("iterations must be > 0");
+            opts.iterations = val;
+        }
+        else if (arg.rfind("-K=", 0) == 0) {
+            string kval = arg.substr(3);
+            if (kval != "scalar" && kval != "simd" && kval != "tiled" && kval != "prefetch")
+                throw runtime_error("Invalid kernel type. Allowed: scalar, simd, tiled, prefetch");
+            opts.kernel = kval;
+        }
+        else if (arg.rfind("-tile=", 0) == 0) {
+            val = stoi(arg.substr(6));
+            if (val <= 0) throw runtime_error("tile columns must be > 0");
+            opts.tileCols = val;
+        }
+        else if (arg.rfind("-pfdist=", 0) == 0) {
+            val = stoi(arg.substr(8));
+            if (val <= 0) throw runtime_error("prefetch distance must be > 0");
+            opts.prefetchDist = val;
+        }
+        else if (arg.rfind("-F=", 0) == 0) {
+            string fval = arg.substr(3);
+            if (fval != "csr" && fval != "sell" && fval != "dcsr" && fval != "bcsr" && fval != "auto")
+                throw runtime_error("Invalid storage format. Allowed: csr, sell, dcsr, bcsr, auto");
+            opts.format = fval;
+        }
+        else if (arg.rfind("-B=", 0) == 0) {
+            string bval = arg.substr(3);
+            if (bval != "auto" && bval != "1x1" && bval != "2x2" && bval != "4x4")
+                throw runtime_error("Invalid block size. Allowed: auto, 1x1, 2x2, 4x4");
+            opts.blockSpec = bval;
+        }
+        else if (arg.rfind("-R=", 0) == 0) {
+            string rval = arg.substr(3);
+            if (rval != "none" && rval != "rcm")
+                throw runtime_error("Invalid reordering. Allowed: none, rcm");
+            opts.reorder = rval;
+        }
+        else if (arg.rfind("-threadstats=", 0) == 0) {
+            string tval = arg.substr(13);
+            if (tval != "on" && tval != "off")
+                throw runtime_error("Invalid threadstats value. Allowed: on, off");
+            opts.threadStats = (tval == "on");
+        }
+        else if (arg == "-auto") {
+            opts.autoTune = true;
+        }
+        else if (arg.rfind("-adaptive=", 0) == 0) {
+            double aval = stod(arg.substr(10));
+            if (aval <= 0.0 || aval >= 1.0)
+                throw runtime_error("adaptive relative error must be in (0, 1)");
+            opts.adaptiveRelErr = aval;
+        }
+        else if (arg.rfind("-out=", 0) == 0) {
+            opts.outPath = arg.substr(5);
+            if (opts.outPath.empty()) throw runtime_error("-out requires a file path");
+        }
+        else if (arg.rfind("-timelog=", 0) == 0) {
+            opts.timelogPath = arg.substr(9);
+            if (opts.timelogPath.empty()) throw runtime_error("-timelog requires a file path");
+        }
+        else if (arg.rfind("-op=", 0) == 0) {
+            string oval = arg.substr(4);
+            if (oval != "normal" && oval != "transpose")
+                throw runtime_error("Invalid operation. Allowed: normal, transpose");
+            opts.operation = oval;
+        }
+        else if (arg.rfind("-D=", 0) == 0) {
+            string dval = arg.substr(3);
+            if (dval != "host" && dval != "gpu")
+                throw runtime_error("Invalid device. Allowed: host, gpu");
+            opts.device = dval;
+        }
+        else if (arg.rfind("-seed=", 0) == 0) {
+            long long sval = stoll(arg.substr(6));
+            if (sval < 0) throw runtime_error("seed must be >= 0");
+            opts.seed = sval;
+        }
+        else if (arg.rfind("-stream=", 0) == 0) {
+            long long sval = stoll(arg.substr(8));
+            if (sval <= 0) throw runtime_error("stream block rows must be > 0");
+            opts.streamBlockRows = sval;
+        }
+        else if (arg.rfind("-N=", 0) == 0) {
+            string nval = arg.substr(3);
+            if (nval != "none" && nval != "firsttouch" && nval != "interleave")
+                throw runtime_error("Invalid NUMA policy. Allowed: none, firsttouch, interleave");
+            opts.numaPolicy = nval;
+        }
+        else if (arg.rfind("-bind=", 0) == 0) {
+            string bval = arg.substr(6);
+            if (bval != "close" && bval != "spread")
+                throw runtime_error("Invalid bind policy. Allowed: close, spread");
+            opts.bindPolicy = bval;
+        }
+        else if (arg.rfind("-P=", 0) == 0) {
+            string pval = arg.substr(3);
+            if (pval != "fp64" && pval != "fp32")
+                throw runtime_error("Invalid precision. Allowed: fp64, fp32");
+            opts.precision = pval;
+        }
+        else if (arg.rfind("-V=", 0) == 0) {
+            val = stoi(arg.substr(3));
+            if (val <= 0) throw runtime_error("numVectors must be > 0");
+            opts.numVectors = val;
+        }
+        else if (arg.rfind("-M=", 0) == 0) {
+            string mval = arg.substr(3);
+            if (mval != "expand" && mval != "half")
+                throw runtime_error("Invalid symmetry mode. Allowed: expand, half");
+            opts.symmetryMode = mval;
+        }
+        else if (arg.rfind("-sweep=", 0) == 0) {
+            if (arg.size() == 7)
+                throw runtime_error("Empty sweep specification");
+            opts.sweepSpec = arg.substr(7); // validated by parseSweepSpec
+        }
+        else {
+            throw runtime_error("Unknown argument: '" + arg + "'");
+        }
+    }
+
+    // The SELL and DCSR kernels are single-vector; fall back instead of
+    // mis-sizing the blocks
+    if (opts.format != "csr" && opts.numVectors > 1) {
+        resultsManager.addError("SpMM mode (-V > 1) is only available with -F=csr. Using a single vector.");
+        opts.numVectors = 1;
+    }
+
+    // Cap requested threads to max available, instead of throwing error the execution continues reporting the error
+    #ifdef _OPENMP
+        int maxThreads = omp_get_max_threads();
+        if (opts.numThreads > maxThreads) {
+            resultsManager.addError("Requested threads (" + to_string(opts.numThreads) + ") exceeds maximum available (" + to_string(maxThreads) + "). Using max.");
+            opts.numThreads = maxThreads;
+        }
+    #endif
+
+    return opts;
+}
+
+/*
+    Reordering pass (-R=rcm)
+    ------------------------
+    Applied to the coordinate entries between readMTX and buildFromEntries so
+    every storage format runs on the reordered matrix. The permutation
+    relabels rows and columns alike, which keeps y = Ax equivalent up to the
+    same relabeling of x and y; the harness times the kernel on a synthetic
+    x, so no inverse permutation is applied afterwards. The achieved
+    bandwidth is kept in file statics (one matrix load serves many sweep
+    scenarios, each with its own ResultsManager) and recorded per scenario.
+*/
+static string g_reorderApplied = "none";
+static long long g_bandwidthBefore = 0, g_bandwidthAfter = 0;
+
+static void applyReordering(vector<Entry>& entries, long long rows, long long cols,
+                            const CLIOptions& opts, ResultsManager& resultsManager) {
+    g_reorderApplied = "none";
+    if (opts.reorder != "rcm")
+        return;
+    if (rows != cols) {
+        resultsManager.addError("-R=rcm needs a square matrix. Keeping the original ordering.");
+        return;
+    }
+    g_bandwidthBefore = reorder::matrixBandwidth(entries);
+    vector<int> newOf = reorder::rcmPermutation(entries, (int)rows);
+    reorder::permuteSymmetric(entries, newOf);
+    g_bandwidthAfter = reorder::matrixBandwidth(entries);
+    g_reorderApplied = "rcm";
+}
+
+// Format-specific scenario metadata: only BCSR has anything to add (its tile
+// size and fill-in ratio); the generic overload keeps the call compiling for
+// every other matrix type.
+template <typename MatT>
+static void recordFormatDetails(const MatT&, ResultsManager&) {}
+
+template <typename ValueT, typename IndexT>
+static void recordFormatDetails(const BCSRMatrixT<ValueT, IndexT>& mat, ResultsManager& resultsManager) {
+    resultsManager.setBlockInfo(mat.getBlockR(), mat.getBlockC(), mat.getFillRatio());
+}
+
+// One benchmark scenario (thread count, schedule, chunk size) executed on an
+// already-loaded matrix with pre-allocated vectors. Resolves the kernel and
+// the incompatible-option fallbacks, then warms up, times the iterations and
+// records everything into the given ResultsManager. Shared by the single-run
+// path and the sweep mode.
+template <typename MatT>
+static void runScenario(MatT& csr, const CLIOptions& opts, int numThreads,
+                        const string& schedType, int chunkSize,
+                        const typename MatT::value_type* x, typename MatT::value_type* y,
+                        const string& matrixName, ResultsManager& resultsManager) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
+    (void)sizeof(ValueT);
+    double duration = 0.0;
+
+    #ifdef _OPENMP
+    omp_set_num_threads(numThreads);
+    #endif
+
+    // in order to update the matrix metadata in resultsManager, we need to pass by pointer
+    resultsManager.setInformation(&csr, numThreads, schedType, chunkSize, matrixName);
+    resultsManager.setPrecision(opts.precision);
+    resultsManager.setSymmetryMode(csr.isHalfStored() ? "half" : "expand");
+    resultsManager.setNumVectors(opts.numVectors);
+
+    // Resolve the requested kernel against what this CPU supports.
+    // The SIMD kernels only exist for fp64 with 32-bit indices.
+    string kernel = "scalar";
+    if (opts.kernel == "simd") {
+        kernel = detectSimdKernel();
+        if (kernel == "scalar")
+            resultsManager.addError("SIMD kernel requested but neither AVX2 nor AVX-512 is available. Using scalar.");
+        else if (!SimdRowDot<ValueT, IndexT>::available()) {
+            resultsManager.addError("SIMD kernel is only implemented for fp64 with 32-bit indices. Using scalar.");
+            kernel = "scalar";
+        }
+    } else if (opts.kernel == "tiled") {
+        kernel = "tiled";
+    } else if (opts.kernel == "prefetch") {
+        kernel = "prefetch";
+    }
+
+    // The multi-vector kernel has its own k-wide inner loop, so the SIMD and
+    // nnzbalanced single-vector variants do not compose with it.
+    string scheduling = schedType;
+    if (opts.numVectors > 1) {
+        if (kernel != "scalar") {
+            resultsManager.addError("The " + kernel + " kernel is not available with -V > 1. Using scalar.");
+            kernel = "scalar";
+        }
+        if (scheduling == "nnzbalanced") {
+            resultsManager.addError("nnzbalanced scheduling is not available with -V > 1. Using static.");
+            scheduling = "static";
+        }
+    }
+
+    // The alternative storage formats bring their own inner loops and have no
+    // row-range entry partition, so the CSR-only variants fall back here too.
+    if (MatT::formatName() != "csr") {
+        if (kernel != "scalar") {
+            resultsManager.addError("The " + kernel + " kernel is only available with -F=csr. Using scalar.");
+            kernel = "scalar";
+        }
+        if (scheduling == "nnzbalanced") {
+            resultsManager.addError("nnzbalanced scheduling is only available with -F=csr. Using static.");
+            scheduling = "static";
+        }
+    }
+
+    // The symmetric kernel has its own inner loop and thread partition, so the
+    // SIMD and nnzbalanced variants do not compose with it.
+    if (csr.isHalfStored()) {
+        if (kernel != "scalar") {
+            resultsManager.addError("The " + kernel + " kernel is not available with -M=half. Using scalar.");
+            kernel = "scalar";
+        }
+        if (scheduling == "nnzbalanced") {
+            resultsManager.addError("nnzbalanced scheduling is not available with -M=half. Using static.");
+            scheduling = "static";
+        }
+    }
+    // The transpose product exists for the plain CSR row loop only; every
+    // special-purpose kernel keeps its forward-product form.
+    bool wantTranspose = (opts.operation == "transpose");
+    if (wantTranspose && (MatT::formatName() != "csr" || csr.isHalfStored()
+                          || opts.numVectors > 1 || scheduling == "nnzbalanced"
+                          || kernel != "scalar")) {
+        resultsManager.addError("-op=transpose is only available with the scalar CSR kernel (not with -V > 1, -M=half, -K, nnzbalanced or non-CSR formats). Running the normal product.");
+        wantTranspose = false;
+    }
+    resultsManager.setOperation(wantTranspose ? "transpose" : "normal");
+
+    resultsManager.setKernel(kernel);
+    resultsManager.setFormat(MatT::formatName());
+    resultsManager.setNumaPolicy(opts.numaPolicy);
+    recordFormatDetails(csr, resultsManager);
+    resultsManager.setReorderInfo(g_reorderApplied, g_bandwidthBefore, g_bandwidthAfter);
+
+    // The nnz-balanced partition is computed once per (matrix, thread count)
+    if (scheduling == "nnzbalanced")
+        buildNnzPartition(csr, numThreads);
+
+    // The tiled companion is built once per (matrix arrays, tile width)
+    if (kernel == "tiled") {
+        buildTiledCompanion(csr, (typename MatT::index_type)opts.tileCols);
+        resultsManager.setTileCols(opts.tileCols);
+    }
+
+    // The prefetch kernel reads its lookahead from a per-run static, so the
+    // sweep scenarios share the CLI value
+    if (kernel == "prefetch") {
+        prefetchDistance = opts.prefetchDist;
+        resultsManager.setPrefetchDist(opts.prefetchDist);
+    }
+
+    // The instrumented kernel only exists for the plain CSR row loop; the
+    // special-purpose kernels keep their uninstrumented form.
+    bool wantThreadStats = opts.threadStats;
+    if (wantThreadStats && (MatT::formatName() != "csr" || csr.isHalfStored()
+                            || opts.numVectors > 1 || scheduling == "nnzbalanced"
+                            || kernel == "tiled" || kernel == "prefetch" || wantTranspose)) {
+        resultsManager.addError("-threadstats=on is only available with the CSR row kernels (not with -V > 1, -M=half, -K=tiled/prefetch, -op=transpose, nnzbalanced or non-CSR formats). Thread stats disabled.");
+        wantThreadStats = false;
+    }
+
+    // Warm-up Phase (the transpose flag covers the warm-up too, so its
+    // byte/FLOP model matches the kernel that actually runs)
+    transposeOp = wantTranspose;
+    size_t bytesMoved = 0, flopsMoved = 0;
+    warmUp(csr, x, y, duration, scheduling, chunkSize, bytesMoved, flopsMoved, opts.numVectors);
+    resultsManager.setWarmupDuration(duration);
+    resultsManager.setRealTimeMetrics(bytesMoved, flopsMoved);
+
+    // Actual Timed iterations, bracketed by the hardware counters so the
+    // measured traffic covers exactly the timed work
+    threadStatsEnabled = wantThreadStats;
+    if (wantThreadStats)
+        threadBusySeconds.assign(numThreads, 0.0);
+
+    resultsManager.startHwCounters();
+    if (opts.adaptiveRelErr > 0.0) {
+        // Adaptive mode: iterate until the p90's confidence interval is
+        // narrow enough, with -I as the budget cap (raise it for noisy
+        // matrices — the stopping rule is what saves the quiet ones)
+        resultsManager.configureAdaptive(opts.adaptiveRelErr, 8, max(opts.iterations, 8));
+        do {
+            SpMV(csr, x, y, duration, scheduling, chunkSize, kernel, opts.numVectors);
+            resultsManager.addIterationDuration(duration);
+        } while (resultsManager.needMoreIterations());
+    } else {
         for (int i = 0; i < opts.iterations; i++) {
-            outputVector.reset(SpMV(csr, inputVector.get(), duration, opts.schedulingType, opts.chunkSize));
+            SpMV(csr, x, y, duration, scheduling, chunkSize, kernel, opts.numVectors);
             resultsManager.addIterationDuration(duration);
         }
+    }
+    resultsManager.stopHwCounters();
+    transposeOp = false;
 
-        // compute statistics about the runs
-        resultsManager.computeAllMetrics();
+    if (wantThreadStats) {
+        threadStatsEnabled = false;
+        vector<double> busyMs(threadBusySeconds.size());
+        for (size_t t = 0; t < threadBusySeconds.size(); t++)
+            busyMs[t] = threadBusySeconds[t] * 1e3;
+        resultsManager.setThreadStats(busyMs);
+    }
 
-        cout << resultsManager.toJSON() << endl;
+    // compute statistics about the runs
+    resultsManager.computeAllMetrics();
+}
+
+// Format-specific matrix loading. CSR goes through the binary sidecar cache
+// and supports -M=half; SELL is rebuilt from the .mtx entries (row sorting
+// and chunk packing are cheap next to the parse, so it has no sidecar yet).
+template <typename ValueT, typename IndexT>
+static void loadMatrix(CSRMatrixT<ValueT, IndexT>& csr, const CLIOptions& opts,
+                       ResultsManager& resultsManager) {
+    // Symmetric files are expanded by default; -M=half keeps the triangle.
+    // The multi-vector kernel needs the full structure, so -V > 1 forces expand.
+    string symmetryMode = opts.symmetryMode;
+    if (opts.numVectors > 1 && symmetryMode == "half") {
+        resultsManager.addError("-M=half is not available with -V > 1. Expanding the matrix.");
+        symmetryMode = "expand";
+    }
+
+    // The reordering pass works on the coordinate entries, so it bypasses the
+    // binary sidecar cache (which stores the file's original ordering). A
+    // permuted triangle lands in both triangles, so -M=half cannot combine.
+    if (opts.reorder != "none") {
+        if (symmetryMode == "half")
+            resultsManager.addError("-M=half is not available with -R=" + opts.reorder + ". Expanding the matrix.");
+        mtx::MTXHeader header;
+        vector<Entry> entries = mtx::readMTX(opts.filePath, &header);
+        if (header.symmetric)
+            mtx::expandSymmetric(entries, header.skew);
+        applyReordering(entries, header.rows, header.cols, opts, resultsManager);
+        csr.buildFromEntries(entries);
+        return;
+    }
+
+    csr.loadFromMTX(opts.filePath, symmetryMode);
+}
+
+template <typename ValueT, typename IndexT>
+static void loadMatrix(SELLMatrixT<ValueT, IndexT>& mat, const CLIOptions& opts,
+                       ResultsManager& resultsManager) {
+    if (opts.symmetryMode == "half")
+        resultsManager.addError("-M=half is only available with -F=csr. Expanding the matrix.");
+
+    mtx::MTXHeader header;
+    vector<Entry> entries = mtx::readMTX(opts.filePath, &header);
+    if (header.symmetric)
+        mtx::expandSymmetric(entries, header.skew);
+    applyReordering(entries, header.rows, header.cols, opts, resultsManager);
+    mat.buildFromEntries(entries);
+}
+
+template <typename ValueT, typename IndexT>
+static void loadMatrix(DCSRMatrixT<ValueT, IndexT>& mat, const CLIOptions& opts,
+                       ResultsManager& resultsManager) {
+    if (opts.symmetryMode == "half")
+        resultsManager.addError("-M=half is only available with -F=csr. Expanding the matrix.");
+
+    mtx::MTXHeader header;
+    vector<Entry> entries = mtx::readMTX(opts.filePath, &header);
+    if (header.symmetric)
+        mtx::expandSymmetric(entries, header.skew);
+    applyReordering(entries, header.rows, header.cols, opts, resultsManager);
+    mat.buildFromEntries(entries);
+}
+
+template <typename ValueT, typename IndexT>
+static void loadMatrix(BCSRMatrixT<ValueT, IndexT>& mat, const CLIOptions& opts,
+                       ResultsManager& resultsManager) {
+    if (opts.symmetryMode == "half")
+        resultsManager.addError("-M=half is only available with -F=csr. Expanding the matrix.");
+
+    // -B=auto lets the build pick the tile size; an explicit <r>x<c> forces it
+    if (opts.blockSpec == "auto") {
+        mat.setBlockSize(0, 0);
+    } else {
+        size_t x = opts.blockSpec.find('x');
+        mat.setBlockSize(stoi(opts.blockSpec.substr(0, x)), stoi(opts.blockSpec.substr(x + 1)));
+    }
+
+    mtx::MTXHeader header;
+    vector<Entry> entries = mtx::readMTX(opts.filePath, &header);
+    if (header.symmetric)
+        mtx::expandSymmetric(entries, header.skew);
+    applyReordering(entries, header.rows, header.cols, opts, resultsManager);
+    mat.buildFromEntries(entries);
+}
+
+// Shared setup of the single-run and sweep paths: load the matrix, apply the
+// NUMA placement, then build the input block and a reusable pre-touched output
+// block. Allocating the vectors once keeps every scenario free of heap
+// traffic and page faults.
+template <typename MatT>
+static void prepareRun(const CLIOptions& opts, ResultsManager& resultsManager,
+                       MatT& csr,
+                       unique_ptr<typename MatT::value_type[]>& inputVector,
+                       unique_ptr<typename MatT::value_type[]>& outputVector,
+                       string& matrixName) {
+    typedef typename MatT::value_type ValueT;
+
+    loadMatrix(csr, opts, resultsManager);
+
+    matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
+
+    // Apply NUMA placement to the CSR arrays before any vector is touched
+    if (opts.numaPolicy != "none") {
+        if (MatT::formatName() == "csr") {
+            applyNumaPlacement(csr, opts.numaPolicy);
+        } else {
+            resultsManager.addError("NUMA matrix placement is only implemented for -F=csr. Matrix pages keep their first-touch layout.");
+        }
+    }
+
+    // With -V=k, X and Y are row-major blocks of k columns per row. The
+    // transpose operation swaps the vector roles (x over rows, y over cols);
+    // both buffers are sized for either direction so a scenario that falls
+    // back to the normal operation never outgrows them.
+    long xLen = (long)csr.getCols() * opts.numVectors;
+    long yLen = (long)csr.getRows() * opts.numVectors;
+    if (opts.operation == "transpose")
+        xLen = yLen = (long)max(csr.getRows(), csr.getCols()) * opts.numVectors;
+    unique_ptr<double[]> randomVector(generateRandomVector(xLen, -1000.0, 1000.0, opts.seed));
+    inputVector.reset(new ValueT[xLen]);
+    for (long i = 0; i < xLen; i++) inputVector[i] = (ValueT)randomVector[i];
+    randomVector.reset(nullptr);
+    outputVector.reset(new ValueT[yLen]);
+
+    if (opts.numaPolicy != "none") {
+        // Re-place x with the requested policy and first-touch y in
+        // parallel with the kernel's row partition
+        inputVector.reset(numaCopyArray(inputVector.get(), xLen, opts.numaPolicy));
+        ValueT* y = outputVector.get();
+        #pragma omp parallel for schedule(static)
+        for (long i = 0; i < yLen; i++) y[i] = ValueT(0);
+    } else {
+        for (long i = 0; i < yLen; i++) outputVector[i] = ValueT(0);
+    }
+}
+
+/*
+    Structure profile and automatic format selection (-F=auto)
+    ----------------------------------------------------------
+    Choosing between CSR, SELL and BCSR (and between the kernels) per matrix
+    used to take a sweep per candidate. The profile pass reads the structure
+    instead: row-length statistics and a log2 histogram, the column bandwidth
+    of the gather, and what a 2x2 blocking would cost in padded zeros — all
+    from one extra CSR load (which the binary sidecar makes cheap) in
+    parallel passes over the row pointers. The numbers go to a
+    "matrix_profile" JSON section, and simple documented thresholds turn
+    them into the format and kernel of the run.
+*/
+struct MatrixProfile {
+    long long emptyRows = 0;
+    long long rowMin = 0, rowMax = 0;   // over the non-empty rows
+    double rowMean = 0.0;
+    double rowCV = 0.0;                  // stdev / mean of the row lengths
+    vector<long long> rowHistLog2;       // rows with length in [2^k, 2^(k+1))
+    long long bandwidth = 0;             // max |i - j| over the stored entries
+    double blockFill2x2 = 0.0;           // stored / logical values of a 2x2 blocking
+};
+
+template <typename ValueT, typename IndexT>
+static MatrixProfile profileStructure(const CSRMatrixT<ValueT, IndexT>& csr) {
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    IndexT rows = csr.getRows();
+    long long nnz = (long long)csr.getNNZ();
+
+    MatrixProfile p;
+    p.rowHistLog2.assign(64, 0);
+
+    // Row-length statistics, histogram and gather bandwidth in one pass.
+    // The histogram merges per-thread partials; everything else reduces.
+    long long rowMin = nnz > 0 ? nnz : 0, rowMax = 0, empty = 0, bw = 0;
+    double sum = 0.0, sumsq = 0.0;
+    #pragma omp parallel
+    {
+        vector<long long> localHist(64, 0);
+        #pragma omp for schedule(static) reduction(min:rowMin) reduction(max:rowMax,bw) \
+                                         reduction(+:empty,sum,sumsq)
+        for (IndexT i = 0; i < rows; i++) {
+            long long len = (long long)(rowPtr[i + 1] - rowPtr[i]);
+            if (len == 0) { empty++; continue; }
+            if (len < rowMin) rowMin = len;
+            if (len > rowMax) rowMax = len;
+            sum += (double)len;
+            sumsq += (double)len * len;
+            int bucket = 0;
+            for (long long l = len; l > 1; l >>= 1) bucket++;
+            localHist[bucket]++;
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++) {
+                long long d = (long long)colIdx[j] - i;
+                if (d < 0) d = -d;
+                if (d > bw) bw = d;
+            }
+        }
+        #pragma omp critical
+        for (int b = 0; b < 64; b++) p.rowHistLog2[b] += localHist[b];
+    }
+    long long filled = (long long)rows - empty;
+    p.emptyRows = empty;
+    p.rowMin = filled > 0 ? rowMin : 0;
+    p.rowMax = rowMax;
+    p.rowMean = filled > 0 ? sum / filled : 0.0;
+    if (filled > 0 && p.rowMean > 0.0) {
+        double var = sumsq / filled - p.rowMean * p.rowMean;
+        p.rowCV = sqrt(var > 0.0 ? var : 0.0) / p.rowMean;
+    }
+    p.bandwidth = bw;
+    while (p.rowHistLog2.size() > 1 && p.rowHistLog2.back() == 0)
+        p.rowHistLog2.pop_back();
+
+    // Distinct 2x2 blocks, counted per row pair by merging the two sorted
+    // column lists on their block ids (the CSR build sorts every row)
+    long long blocks = 0;
+    #pragma omp parallel for schedule(static) reduction(+:blocks)
+    for (IndexT r = 0; r < rows; r += 2) {
+        IndexT a = rowPtr[r], aEnd = rowPtr[r + 1];
+        IndexT b = aEnd, bEnd = aEnd;
+        if (r + 1 < rows) { b = rowPtr[r + 1]; bEnd = rowPtr[r + 2]; }
+        long long last = -1;
+        while (a < aEnd || b < bEnd) {
+            long long blkA = a < aEnd ? (long long)(colIdx[a] >> 1) : -1;
+            long long blkB = b < bEnd ? (long long)(colIdx[b] >> 1) : -1;
+            long long blk;
+            if (blkA >= 0 && (blkB < 0 || blkA <= blkB)) { blk = blkA; a++; }
+            else { blk = blkB; b++; }
+            if (blk != last) { blocks++; last = blk; }
+        }
+    }
+    if (nnz > 0)
+        p.blockFill2x2 = (double)(blocks * 4) / nnz;
+    return p;
+}
+
+// Thresholds turning the profile into a (format, kernel) pair
+static void chooseFormatAndKernel(const MatrixProfile& p, int valueBytes,
+                                  string& format, string& kernel) {
+    if (p.blockFill2x2 > 0.0 && p.blockFill2x2 <= 1.6) {
+        // A 2x2 blocking storing < ~1.6 values per nonzero saves more index
+        // traffic than its padded zeros cost
+        format = "bcsr";
+        kernel = "scalar"; // the special kernels are CSR-only
+    } else if (p.rowCV <= 0.35 && p.emptyRows == 0) {
+        // Regular row lengths vectorize in SELL lanes with little padding
+        format = "sell";
+        kernel = "scalar";
+    } else {
+        format = "csr";
+        // A gather spanning more x than a last-level cache holds cannot stay
+        // resident, so software prefetch hides the DRAM latency; otherwise
+        // the SIMD row dot wins (runScenario falls back without AVX)
+        kernel = ((double)p.bandwidth * valueBytes > 32.0 * (1 << 20))
+                     ? "prefetch" : "simd";
+    }
+}
+
+// -F=auto entry point: profile on an expanded CSR load (the run reloads in
+// the chosen format; for CSR the sidecar cache makes that nearly free) and
+// replace the format/kernel of the run with the thresholds' pick
+template <typename ValueT>
+static void selectFormatAndKernel(CLIOptions& opts, ResultsManager& resultsManager) {
+    CSRMatrixT<ValueT, csr_index_t> csr;
+    csr.loadFromMTX(opts.filePath);
+    MatrixProfile p = profileStructure(csr);
+    resultsManager.setMatrixProfile(p.emptyRows, p.rowMin, p.rowMax, p.rowMean,
+                                    p.rowCV, p.rowHistLog2, p.bandwidth, p.blockFill2x2);
+    chooseFormatAndKernel(p, (int)sizeof(ValueT), opts.format, opts.kernel);
+}
+
+/*
+    Online auto-tuner (-auto)
+    -------------------------
+    scripts/selectConfigs.py picks configurations offline from a full
+    exhaustive sweep — expensive to regenerate whenever the matrices or the
+    machine change. The tuner searches (threads, scheduling, chunk) at run
+    time instead: stage 1 climbs a power-of-two thread ladder with the
+    static schedule and stops when more threads stop helping, stage 2 probes
+    a short list of schedule/chunk candidates at the winning thread count,
+    abandoning a candidate after one probe when it is far off the best. A
+    few kernel runs per candidate put the whole search at seconds.
+
+    The winner is cached in results/autotune_cache.txt keyed by matrix,
+    host, core count, format and precision, so the next launch skips the
+    search entirely; delete the line (or the file) to re-tune. Probes run
+    the forward product with the requested kernel — the timed workload may
+    still layer -op/-threadstats on top of the tuned configuration.
+*/
+static const char* AUTOTUNE_CACHE_PATH = "results/autotune_cache.txt";
+
+// One cache line: matrix host procs format precision -> threads sched chunk
+static string autoTuneKey(const string& matrixName, const string& format,
+                          const string& precision) {
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    #ifdef _OPENMP
+    int procs = omp_get_num_procs();
+    #else
+    int procs = 1;
+    #endif
+    return matrixName + " " + host + " " + to_string(procs) + " " + format + " " + precision;
+}
+
+template <typename MatT>
+static void autoTuneScenario(MatT& csr, const CLIOptions& opts,
+                             const typename MatT::value_type* x, typename MatT::value_type* y,
+                             const string& matrixName, ResultsManager& resultsManager,
+                             int& threads, string& sched, int& chunk) {
+    string key = autoTuneKey(matrixName, MatT::formatName(), opts.precision);
+
+    // Cached winner: instant reuse from a previous launch on this machine
+    {
+        ifstream cache(AUTOTUNE_CACHE_PATH);
+        string line;
+        while (getline(cache, line)) {
+            if (line.rfind(key + " ", 0) != 0) continue;
+            istringstream iss(line.substr(key.size() + 1));
+            int t, c;
+            string s;
+            if (iss >> t >> s >> c) {
+                threads = t;
+                sched = s;
+                chunk = c;
+                resultsManager.setAutoTune("cache", 0.0);
+                return;
+            }
+        }
+    }
+
+    #ifdef _OPENMP
+    int maxThreads = omp_get_num_procs();
+    double tuneStart = omp_get_wtime();
+    #else
+    int maxThreads = 1;
+    double tuneStart = 0.0;
+    #endif
+    double duration = 0.0;
+
+    // Fault the matrix and vector pages in before anything is timed (the
+    // probes run the requested kernel, so its knobs apply here too)
+    prefetchDistance = opts.prefetchDist;
+    SpMV(csr, x, y, duration, "static", 0, opts.kernel, opts.numVectors);
+
+    // Stage 1: thread ladder under the static schedule. More threads stop
+    // paying once the memory bus saturates, so the climb ends at the first
+    // count that is clearly slower than the best so far.
+    int bestThreads = 1;
+    double bestMs = 1e300;
+    for (int t = 1; t <= maxThreads; t = (t * 2 <= maxThreads || t == maxThreads) ? t * 2 : maxThreads) {
+        #ifdef _OPENMP
+        omp_set_num_threads(t);
+        #endif
+        double ms = 1e300;
+        for (int probe = 0; probe < 2; probe++) {
+            SpMV(csr, x, y, duration, "static", 0, opts.kernel, opts.numVectors);
+            ms = min(ms, duration);
+        }
+        if (ms < bestMs) {
+            bestMs = ms;
+            bestThreads = t;
+        } else if (ms > bestMs * 1.1) {
+            break; // prune the rest of the ladder
+        }
+    }
+
+    // Stage 2: schedule/chunk shortlist at the winning thread count. A
+    // candidate much slower after its first probe is dropped immediately.
+    struct Candidate { const char* sched; int chunk; };
+    static const Candidate candidates[] = {
+        {"static", 0}, {"static", 64}, {"dynamic", 64}, {"dynamic", 256},
+        {"guided", 0}, {"guided", 64}, {"nnzbalanced", 0},
+    };
+
+    #ifdef _OPENMP
+    omp_set_num_threads(bestThreads);
+    #endif
+    string bestSched = "static";
+    int bestChunk = 0;
+    bestMs = 1e300;
+    for (size_t c = 0; c < sizeof(candidates) / sizeof(candidates[0]); c++) {
+        string candSched = candidates[c].sched;
+        if (candSched == "nnzbalanced") {
+            if (MatT::formatName() != "csr" || csr.isHalfStored() || opts.numVectors > 1)
+                continue; // the balanced partition only exists for the CSR row kernel
+            buildNnzPartition(csr, bestThreads);
+        }
+        SpMV(csr, x, y, duration, candSched, candidates[c].chunk, opts.kernel, opts.numVectors);
+        double ms = duration;
+        if (ms < bestMs * 1.3) { // close enough to deserve the confirming probes
+            for (int probe = 0; probe < 2; probe++) {
+                SpMV(csr, x, y, duration, candSched, candidates[c].chunk, opts.kernel, opts.numVectors);
+                ms = min(ms, duration);
+            }
+        }
+        if (ms < bestMs) {
+            bestMs = ms;
+            bestSched = candSched;
+            bestChunk = candidates[c].chunk;
+        }
+    }
+
+    threads = bestThreads;
+    sched = bestSched;
+    chunk = bestChunk;
+    #ifdef _OPENMP
+    resultsManager.setAutoTune("search", (omp_get_wtime() - tuneStart) * 1e3);
+    #else
+    resultsManager.setAutoTune("search", tuneStart);
+    #endif
+
+    // Persist the winner, keeping the other machines' and matrices' lines.
+    // Best-effort like the sidecar cache: no results/ directory, no cache.
+    vector<string> lines;
+    {
+        ifstream cache(AUTOTUNE_CACHE_PATH);
+        string line;
+        while (getline(cache, line))
+            if (line.rfind(key + " ", 0) != 0 && !line.empty())
+                lines.push_back(line);
+    }
+    ofstream cache(AUTOTUNE_CACHE_PATH, ios::trunc);
+    if (cache.is_open()) {
+        for (size_t i = 0; i < lines.size(); i++)
+            cache << lines[i] << "\n";
+        cache << key << " " << threads << " " << sched << " " << chunk << "\n";
+    }
+}
+
+// Whole benchmark for one matrix instantiation: load, place, warm up, run,
+// record. The index type follows the project-wide csr_index_t (Makefile
+// INDEX64 knob); the value type and storage format come from MatT.
+template <typename MatT>
+static void runBenchmark(const CLIOptions& opts, ResultsManager& resultsManager) {
+    typedef typename MatT::value_type ValueT;
+
+    MatT csr;
+    unique_ptr<ValueT[]> inputVector, outputVector;
+    string matrixName;
+    prepareRun(opts, resultsManager, csr, inputVector, outputVector, matrixName);
+
+    // -auto replaces the CLI scenario with the tuned (or cached) winner
+    int threads = opts.numThreads;
+    string sched = opts.schedulingType;
+    int chunk = opts.chunkSize;
+    if (opts.autoTune)
+        autoTuneScenario(csr, opts, inputVector.get(), outputVector.get(),
+                         matrixName, resultsManager, threads, sched, chunk);
+
+    runScenario(csr, opts, threads, sched, chunk,
+                inputVector.get(), outputVector.get(), matrixName, resultsManager);
+}
+
+/*
+    Out-of-core streaming mode (-stream=<rows_per_block>)
+    -----------------------------------------------------
+    The matrix is never materialized in memory: the binary sidecar is mmap'd
+    and walked in row blocks, with a prefetch thread hiding the disk behind
+    the compute (engine in StreamCSR.h). The sidecar is produced on first use
+    through the normal loader — for matrices that genuinely exceed RAM it is
+    converted once on a bigger machine and shipped alongside the .mtx. Only
+    the plain scalar CSR pass exists out of core, so the format/kernel/NUMA
+    options that need the whole matrix in memory are ignored with a warning.
+*/
+template <typename ValueT>
+static void runStreamBenchmark(const CLIOptions& opts, ResultsManager& resultsManager) {
+    typedef csr_index_t IndexT;
+
+    if (opts.format != "csr" || opts.kernel != "scalar" || opts.symmetryMode != "expand"
+        || opts.numVectors > 1 || opts.reorder != "none" || opts.numaPolicy != "none"
+        || opts.schedulingType == "nnzbalanced" || opts.threadStats || opts.device != "host"
+        || opts.operation != "normal")
+        resultsManager.addError("-stream only supports the forward scalar CSR pass; -F/-K/-M/-V/-R/-N/-D/-op/-S=nnzbalanced/-threadstats are ignored.");
+
+    // Make sure an up-to-date sidecar exists; the conversion loads the matrix
+    // once through the normal path and is skipped when the cache is current
+    string binPath = CSRMatrixT<ValueT, IndexT>::sidecarPath(opts.filePath);
+    struct stat mtxSt, binSt;
+    if (stat(binPath.c_str(), &binSt) != 0
+        || (stat(opts.filePath.c_str(), &mtxSt) == 0 && binSt.st_mtime < mtxSt.st_mtime)) {
+        CSRMatrixT<ValueT, IndexT> converter;
+        converter.loadFromMTX(opts.filePath);
+        if (stat(binPath.c_str(), &binSt) != 0)
+            throw runtime_error("Streaming needs the binary sidecar, and it could not be written next to " + opts.filePath);
+    }
+
+    stream::StreamedCSR<ValueT, IndexT> mat;
+    mat.open(binPath);
+
+    string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
+    resultsManager.setInformation(&mat, opts.numThreads, opts.schedulingType, opts.chunkSize, matrixName);
+    resultsManager.setPrecision(opts.precision);
+
+    long long blockRows = min(opts.streamBlockRows, mat.getRows());
+    long long numBlocks = (mat.getRows() + blockRows - 1) / blockRows;
+
+    unique_ptr<double[]> randomVector(generateRandomVector(mat.getCols(), -1000.0, 1000.0, opts.seed));
+    unique_ptr<ValueT[]> x(new ValueT[mat.getCols()]);
+    for (long long i = 0; i < mat.getCols(); i++) x[i] = (ValueT)randomVector[i];
+    randomVector.reset(nullptr);
+    unique_ptr<ValueT[]> y(new ValueT[mat.getRows()]());
+
+    #ifdef _OPENMP
+    omp_set_num_threads(opts.numThreads);
+    omp_sched_t schedule = omp_sched_static;
+    if (opts.schedulingType == "dynamic") schedule = omp_sched_dynamic;
+    else if (opts.schedulingType == "guided") schedule = omp_sched_guided;
+    omp_set_schedule(schedule, opts.chunkSize);
+    #endif
+
+    // Warm-up pass (also faults the row pointers in); not part of the overlap stats
+    double ioWaitMs = 0.0, computeMs = 0.0;
+    double duration = mat.pass(x.get(), y.get(), blockRows, ioWaitMs, computeMs);
+    resultsManager.setWarmupDuration(duration);
+
+    ioWaitMs = computeMs = 0.0;
+    for (int i = 0; i < opts.iterations; i++) {
+        duration = mat.pass(x.get(), y.get(), blockRows, ioWaitMs, computeMs);
+        resultsManager.addIterationDuration(duration);
+    }
+    resultsManager.setStreamStats(blockRows, numBlocks, ioWaitMs, computeMs);
+
+    resultsManager.computeAllMetrics();
+}
+
+/*
+    GPU offload mode (-D=gpu)
+    -------------------------
+    The same CSR arrays, walked by an OpenMP "target teams distribute"
+    region instead of the host row loop. The matrix, the row pointers and x
+    move to the device exactly once (target enter data, not timed), every
+    iteration runs entirely on the device, and y is mapped back only after
+    the last one — so the timed loop sees device HBM bandwidth, not PCIe.
+    Built with "make parallel-offload" the region runs on the GPU; in the
+    plain build (or when no device is present) the OpenMP runtime falls back
+    to executing it on the host, which is reported as a warning. Only the
+    plain fp32/fp64 CSR pass exists on the device, so the host-side format,
+    kernel and placement options are ignored with a warning.
+*/
+template <typename ValueT>
+static void runGpuBenchmark(const CLIOptions& opts, ResultsManager& resultsManager) {
+    typedef csr_index_t IndexT;
+
+    if (opts.format != "csr" || opts.kernel != "scalar" || opts.symmetryMode != "expand"
+        || opts.numVectors > 1 || opts.reorder != "none" || opts.numaPolicy != "none"
+        || opts.schedulingType != "static" || opts.threadStats || opts.operation != "normal")
+        resultsManager.addError("-D=gpu only supports the plain forward CSR pass; -F/-K/-M/-V/-R/-N/-S/-op/-threadstats are ignored.");
+
+    CSRMatrixT<ValueT, IndexT> csr;
+    csr.loadFromMTX(opts.filePath);
+
+    string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
+    resultsManager.setInformation(&csr, opts.numThreads, opts.schedulingType, opts.chunkSize, matrixName);
+    resultsManager.setPrecision(opts.precision);
+    resultsManager.setDevice("gpu");
+    resultsManager.setKernel("target");
+
+    #ifdef _OPENMP
+    if (omp_get_num_devices() == 0)
+        resultsManager.addError("No offload device found; the target regions run on the host fallback. Build with 'make parallel-offload' on a GPU node for real offload.");
+    #endif
+
+    IndexT rows = csr.getRows();
+    IndexT cols = csr.getCols();
+    long long nnz = (long long)csr.getNNZ();
+    const IndexT* rowPtr = csr.getIndexPointersPtr();
+    const IndexT* colIdx = csr.getIndicesPtr();
+    const ValueT* val = csr.getDataPtr();
+
+    unique_ptr<double[]> randomVector(generateRandomVector(cols, -1000.0, 1000.0, opts.seed));
+    unique_ptr<ValueT[]> xBuf(new ValueT[cols]);
+    for (IndexT i = 0; i < cols; i++) xBuf[i] = (ValueT)randomVector[i];
+    randomVector.reset(nullptr);
+    unique_ptr<ValueT[]> yBuf(new ValueT[rows]());
+    const ValueT* x = xBuf.get();
+    ValueT* y = yBuf.get();
+
+    // One-time transfer: everything the kernel reads goes over once, y is
+    // only allocated on the device and comes back after the last iteration
+    #pragma omp target enter data map(to: rowPtr[0:rows+1], colIdx[0:nnz], val[0:nnz], x[0:cols]) map(alloc: y[0:rows])
+
+    // Warm-up iteration (also JITs/loads the device kernel); the byte/FLOP
+    // model is the same CSR accounting as the host warm-up
+    double start = 0.0, duration = 0.0;
+    #ifdef _OPENMP
+    start = omp_get_wtime();
+    #endif
+    #pragma omp target teams distribute parallel for
+    for (IndexT i = 0; i < rows; i++) {
+        ValueT sum = ValueT(0);
+        for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+            sum += val[j] * x[colIdx[j]];
+        y[i] = sum;
+    }
+    #ifdef _OPENMP
+    duration = (omp_get_wtime() - start) * 1e3;
+    #endif
+    resultsManager.setWarmupDuration(duration);
+    size_t bytesMoved = (size_t)nnz * (2 * sizeof(ValueT) + sizeof(IndexT))
+                      + (size_t)rows * sizeof(ValueT);
+    resultsManager.setRealTimeMetrics(bytesMoved, (size_t)nnz * 2);
+
+    for (int it = 0; it < opts.iterations; it++) {
+        #ifdef _OPENMP
+        start = omp_get_wtime();
+        #endif
+        #pragma omp target teams distribute parallel for
+        for (IndexT i = 0; i < rows; i++) {
+            ValueT sum = ValueT(0);
+            for (IndexT j = rowPtr[i]; j < rowPtr[i + 1]; j++)
+                sum += val[j] * x[colIdx[j]];
+            y[i] = sum;
+        }
+        #ifdef _OPENMP
+        duration = (omp_get_wtime() - start) * 1e3;
+        #endif
+        resultsManager.addIterationDuration(duration);
+    }
+
+    // y comes back exactly once; the read-only arrays are just released
+    #pragma omp target exit data map(from: y[0:rows]) map(delete: rowPtr[0:rows+1], colIdx[0:nnz], val[0:nnz], x[0:cols])
+
+    resultsManager.computeAllMetrics();
+}
+
+/*
+    Sweep mode (-sweep=threads:...;sched:...;chunk:...)
+    ---------------------------------------------------
+    The tuning scripts used to launch one process per (threads, scheduling,
+    chunk) combination, and every launch re-parsed the .mtx file although only
+    the scenario changed; on the larger matrices the sweep spends nearly all
+    of its wall time in that redundant loading. Here the matrix and the
+    vectors are prepared once and all combinations run in-process, emitting
+    one JSON array with a per-scenario block identical to a single run's.
+*/
+struct SweepSpec {
+    vector<int> threads;
+    vector<string> scheds;
+    vector<int> chunks;
+};
+
+static vector<string> splitList(const string& s, char sep) {
+    vector<string> out;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, sep))
+        if (!item.empty()) out.push_back(item);
+    return out;
+}
+
+// Parse "threads:1,2,4;sched:static,dynamic;chunk:0,64"; missing keys fall
+// back to the single value given by (or defaulted in) the normal options.
+static SweepSpec parseSweepSpec(const string& spec, const CLIOptions& opts) {
+    SweepSpec sweep;
+    for (const string& term : splitList(spec, ';')) {
+        size_t colon = term.find(':');
+        if (colon == string::npos)
+            throw runtime_error("Invalid sweep term '" + term + "'. Expected key:v1,v2,...");
+        string key = term.substr(0, colon);
+        vector<string> vals = splitList(term.substr(colon + 1), ',');
+        if (vals.empty())
+            throw runtime_error("Empty value list in sweep term '" + term + "'");
+
+        if (key == "threads") {
+            for (const string& v : vals) {
+                int t = stoi(v);
+                if (t <= 0) throw runtime_error("Sweep threads must be > 0");
+                sweep.threads.push_back(t);
+            }
+        } else if (key == "sched") {
+            for (const string& v : vals) {
+                if (v != "static" && v != "dynamic" && v != "guided" && v != "nnzbalanced")
+                    throw runtime_error("Invalid sweep scheduling '" + v + "'. Allowed: static, dynamic, guided, nnzbalanced");
+                sweep.scheds.push_back(v);
+            }
+        } else if (key == "chunk") {
+            for (const string& v : vals) {
+                int c = stoi(v);
+                if (c < 0) throw runtime_error("Sweep chunk must be >= 0");
+                sweep.chunks.push_back(c);
+            }
+        } else {
+            throw runtime_error("Unknown sweep key '" + key + "'. Allowed: threads, sched, chunk");
+        }
+    }
+    if (sweep.threads.empty()) sweep.threads.push_back(opts.numThreads);
+    if (sweep.scheds.empty()) sweep.scheds.push_back(opts.schedulingType);
+    if (sweep.chunks.empty()) sweep.chunks.push_back(opts.chunkSize);
+    return sweep;
+}
+
+// Run every combination of the sweep on one loaded matrix, writing the JSON
+// array of per-scenario result blocks to `out` as each scenario finishes —
+// a big -out sweep streams to disk instead of growing an in-memory string.
+template <typename MatT>
+static void runSweep(const CLIOptions& opts, ResultsManager& resultsManager, ostream& out) {
+    typedef typename MatT::value_type ValueT;
+    SweepSpec sweep = parseSweepSpec(opts.sweepSpec, opts);
+
+    MatT csr;
+    unique_ptr<ValueT[]> inputVector, outputVector;
+    string matrixName;
+    prepareRun(opts, resultsManager, csr, inputVector, outputVector, matrixName);
+
+    #ifdef _OPENMP
+    int maxThreads = omp_get_num_procs();
+    #else
+    int maxThreads = 1;
+    #endif
+
+    out << "[\n";
+    bool first = true;
+    for (size_t ti = 0; ti < sweep.threads.size(); ti++) {
+        for (size_t si = 0; si < sweep.scheds.size(); si++) {
+            for (size_t ci = 0; ci < sweep.chunks.size(); ci++) {
+                ResultsManager scenarioManager;
+                // The CLI warnings and load-time fallbacks live on the
+                // run-wide manager, which sweep mode never prints; carry
+                // them into every block so the tuning scripts see them
+                scenarioManager.inheritRunContext(resultsManager);
+                int t = sweep.threads[ti];
+                if (t > maxThreads) {
+                    scenarioManager.addError("Requested threads (" + to_string(t) + ") exceeds maximum available (" + to_string(maxThreads) + "). Using max.");
+                    t = maxThreads;
+                }
+                runScenario(csr, opts, t, sweep.scheds[si], sweep.chunks[ci],
+                            inputVector.get(), outputVector.get(), matrixName, scenarioManager);
+                if (!first) out << ",\n";
+                out << scenarioManager.toJSON();
+                first = false;
+            }
+        }
+    }
+    out << "\n]";
+}
+
+// Main
+int main(int argc, char* argv[]) {
+    ResultsManager resultsManager;
+
+    // Open the perf_event counters before the OpenMP runtime spawns its pool:
+    // they are inherited by threads created afterwards, so every worker's
+    // cycles/misses land in the process-wide counts.
+    ResultsManager::initHwCounters();
+
+    // Thread pinning must be configured before the OpenMP runtime initializes
+    // (which happens on the first omp_* call inside parseCLI), so the NUMA and
+    // bind options are scanned from argv here. User-set env vars win unless
+    // -bind is given explicitly.
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("-N=", 0) == 0 && arg.substr(3) != "none") {
+            setenv("OMP_PLACES", "cores", 0);
+            setenv("OMP_PROC_BIND", "spread", 0);
+        } else if (arg.rfind("-bind=", 0) == 0) {
+            setenv("OMP_PLACES", "cores", 0);
+            setenv("OMP_PROC_BIND", arg.substr(6).c_str(), 1);
+        }
+    }
+
+    try {
+        CLIOptions opts = parseCLI(argc, argv, resultsManager);
+
+        #ifdef _OPENMP
+        omp_set_num_threads(opts.numThreads);
+        #endif
+
+        // -out: a buffered file writer in place of stdout, so large sweeps
+        // stream to disk without round-tripping through the harness pipe
+        vector<char> outBuf;
+        ofstream outFile;
+        ostream* jsonOut = &cout;
+        if (!opts.outPath.empty()) {
+            outBuf.resize(1 << 20);
+            outFile.rdbuf()->pubsetbuf(outBuf.data(), outBuf.size());
+            outFile.open(opts.outPath.c_str(), ios::trunc);
+            if (outFile.is_open())
+                jsonOut = &outFile;
+            else
+                resultsManager.addError("Cannot open -out file '" + opts.outPath + "'. Writing to stdout.");
+        }
+
+        // -timelog: the raw iteration times go to the binary log from here
+        // on; the JSON keeps a pointer per run
+        if (!opts.timelogPath.empty() && !ResultsManager::openTimingLog(opts.timelogPath))
+            resultsManager.addError("Cannot open -timelog file '" + opts.timelogPath + "'. Keeping iteration times in the JSON.");
+
+        // Out-of-core mode never materializes the matrix, so it has its own
+        // benchmark path reading the mmap'd sidecar block by block.
+        // The sweep measures every scenario by design; tuning first would be
+        // redundant work, so -auto yields to -sweep.
+        if (opts.autoTune && !opts.sweepSpec.empty()) {
+            resultsManager.addError("-auto is not available with -sweep. Running the sweep without tuning.");
+            opts.autoTune = false;
+        }
+
+        // -F=auto needs a materialized structure to profile, which the
+        // out-of-core and offload paths (CSR-only anyway) never build
+        if (opts.format == "auto" && (opts.streamBlockRows > 0 || opts.device == "gpu")) {
+            resultsManager.addError("-F=auto is not available with -stream/-D=gpu. Using csr.");
+            opts.format = "csr";
+        }
+
+        if (opts.streamBlockRows > 0) {
+            if (!opts.sweepSpec.empty())
+                resultsManager.addError("-sweep is not available with -stream. Running a single streaming scenario.");
+            if (opts.autoTune)
+                resultsManager.addError("-auto is not available with -stream. Running the requested scenario.");
+            if (opts.precision == "fp32")
+                runStreamBenchmark<float>(opts, resultsManager);
+            else
+                runStreamBenchmark<double>(opts, resultsManager);
+            *jsonOut << resultsManager.toJSON() << endl;
+            return 0;
+        }
+
+        // Offloaded runs keep the matrix resident on the device across the
+        // timed loop, so they get their own benchmark path too.
+        if (opts.device == "gpu") {
+            if (!opts.sweepSpec.empty())
+                resultsManager.addError("-sweep is not available with -D=gpu. Running a single offloaded scenario.");
+            if (opts.autoTune)
+                resultsManager.addError("-auto tunes the host scenario only and is not available with -D=gpu.");
+            if (opts.precision == "fp32")
+                runGpuBenchmark<float>(opts, resultsManager);
+            else
+                runGpuBenchmark<double>(opts, resultsManager);
+            *jsonOut << resultsManager.toJSON() << endl;
+            return 0;
+        }
+
+        // -F=auto resolves here so both the single-run and sweep dispatch
+        // below see a concrete format
+        if (opts.format == "auto") {
+            if (opts.precision == "fp32")
+                selectFormatAndKernel<float>(opts, resultsManager);
+            else
+                selectFormatAndKernel<double>(opts, resultsManager);
+        }
+
+        // Dispatch on the storage format and value precision; everything
+        // below main is templated over the matrix instantiation.
+        // Sweep mode streams its own JSON array of per-scenario blocks.
+        if (!opts.sweepSpec.empty()) {
+            if (opts.format == "sell") {
+                if (opts.precision == "fp32")
+                    runSweep<SELLMatrixT<float, csr_index_t> >(opts, resultsManager, *jsonOut);
+                else
+                    runSweep<SELLMatrixT<double, csr_index_t> >(opts, resultsManager, *jsonOut);
+            } else if (opts.format == "dcsr") {
+                if (opts.precision == "fp32")
+                    runSweep<DCSRMatrixT<float, csr_index_t> >(opts, resultsManager, *jsonOut);
+                else
+                    runSweep<DCSRMatrixT<double, csr_index_t> >(opts, resultsManager, *jsonOut);
+            } else if (opts.format == "bcsr") {
+                if (opts.precision == "fp32")
+                    runSweep<BCSRMatrixT<float, csr_index_t> >(opts, resultsManager, *jsonOut);
+                else
+                    runSweep<BCSRMatrixT<double, csr_index_t> >(opts, resultsManager, *jsonOut);
+            } else {
+                if (opts.precision == "fp32")
+                    runSweep<CSRMatrixT<float, csr_index_t> >(opts, resultsManager, *jsonOut);
+                else
+                    runSweep<CSRMatrixT<double, csr_index_t> >(opts, resultsManager, *jsonOut);
+            }
+            *jsonOut << endl;
+            return 0;
+        }
+
+        if (opts.format == "sell") {
+            if (opts.precision == "fp32")
+                runBenchmark<SELLMatrixT<float, csr_index_t> >(opts, resultsManager);
+            else
+                runBenchmark<SELLMatrixT<double, csr_index_t> >(opts, resultsManager);
+        } else if (opts.format == "dcsr") {
+            if (opts.precision == "fp32")
+                runBenchmark<DCSRMatrixT<float, csr_index_t> >(opts, resultsManager);
+            else
+                runBenchmark<DCSRMatrixT<double, csr_index_t> >(opts, resultsManager);
+        } else if (opts.format == "bcsr") {
+            if (opts.precision == "fp32")
+                runBenchmark<BCSRMatrixT<float, csr_index_t> >(opts, resultsManager);
+            else
+                runBenchmark<BCSRMatrixT<double, csr_index_t> >(opts, resultsManager);
+        } else {
+            if (opts.precision == "fp32")
+                runBenchmark<CSRMatrixT<float, csr_index_t> >(opts, resultsManager);
+            else
+                runBenchmark<CSRMatrixT<double, csr_index_t> >(opts, resultsManager);
+        }
+
+        *jsonOut << resultsManager.toJSON() << endl;
     }
     catch (const exception& e) {
         resultsManager.addError(string("Fatal error: ") + e.what());
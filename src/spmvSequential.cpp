@@ -31,6 +31,9 @@
     -------------
       matrix_path         Path to the input .mtx matrix (REQUIRED)
       -I=<int>            Number of timed iterations (optional, default 1)
+      -P=<string>         Value precision: fp64 | fp32 (optional, default fp64)
+      -seed=<int>         Seed for the random input vector (>= 0); same seed,
+                          same vector (optional, default: hardware seed)
 
     Automatically handles:
       - Validation of user input
@@ -88,14 +91,17 @@ using namespace utils;
 using namespace mtx;
 using namespace chrono;
 
-// SpMV function (sequential)
-double* SpMV(const CSRMatrix& csr, const double* x, double& duration) {
-    double* y = new double[csr.getRows()];
+// SpMV function (sequential), templated over the matrix instantiation.
+// Writes into the caller-owned buffer y so timed iterations do not allocate.
+template <typename MatT>
+void SpMV(const MatT& csr, const typename MatT::value_type* x, typename MatT::value_type* y, double& duration) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
     auto start = high_resolution_clock::now();
 
-    for (int i = 0; i < csr.getRows(); i++) {
-        double sum = 0.0;
-        for (int j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
+    for (IndexT i = 0; i < csr.getRows(); i++) {
+        ValueT sum = ValueT(0);
+        for (IndexT j = csr.getIndexPointers(i); j < csr.getIndexPointers(i+1); j++) {
             sum += csr.getData(j) * x[csr.getIndices(j)];
         }
         y[i] = sum;
@@ -103,40 +109,42 @@ double* SpMV(const CSRMatrix& csr, const double* x, double& duration) {
 
     auto end = high_resolution_clock::now();
     duration = duration_cast<nanoseconds>(end - start).count() / 1e6; // ms
-    return y;
 }
 
-// Warm-up function also counting bytes moved and flops 
-void warmUp(const CSRMatrix& csr, const double* x, double& duration, size_t& bytesMoved, size_t& flopsMoved) {
-    double* y = new double[csr.getRows()];
+// Warm-up function also counting bytes moved and flops
+template <typename MatT>
+void warmUp(const MatT& csr, const typename MatT::value_type* x, typename MatT::value_type* y,
+            double& duration, size_t& bytesMoved, size_t& flopsMoved) {
+    typedef typename MatT::value_type ValueT;
+    typedef typename MatT::index_type IndexT;
     auto start = high_resolution_clock::now();
 
     bytesMoved = 0;
     flopsMoved = 0;
 
-    for (int i = 0; i < csr.getRows(); i++) {
-        double sum = 0.0;
-        for (int j = csr.getIndexPointers(i); j < csr.getIndexPointers(i + 1); j++) {
+    for (IndexT i = 0; i < csr.getRows(); i++) {
+        ValueT sum = ValueT(0);
+        for (IndexT j = csr.getIndexPointers(i); j < csr.getIndexPointers(i + 1); j++) {
             sum += csr.getData(j) * x[csr.getIndices(j)];
-            bytesMoved += sizeof(double); // csr data
-            bytesMoved += sizeof(int);    // csr indices
-            bytesMoved += sizeof(double); // input vector x
+            bytesMoved += sizeof(ValueT); // csr data
+            bytesMoved += sizeof(IndexT); // csr indices
+            bytesMoved += sizeof(ValueT); // input vector x
             flopsMoved += 2;              // 1 mul + 1 add
         }
         y[i] = sum;
-        bytesMoved += sizeof(double); // output vector y
+        bytesMoved += sizeof(ValueT); // output vector y
     }
 
     auto end = high_resolution_clock::now();
     duration = duration_cast<nanoseconds>(end - start).count() / 1e6; // ms
-
-    delete[] y;
 }
 
 // CLI Options
 struct CLIOptions {
     string filePath;
     int iterations = 1;
+    string precision = "fp64"; // fp64 | fp32 (matrix and vector value type)
+    long long seed = -1;       // >= 0 = reproducible input vector
 };
 
 CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
@@ -155,6 +163,15 @@ CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
             int it = stoi(arg.substr(3));
             if (it <= 0) throw runtime_error("Iterations must be > 0");
             opts.iterations = it;
+        } else if (arg.rfind("-P=", 0) == 0) {
+            string pval = arg.substr(3);
+            if (pval != "fp64" && pval != "fp32")
+                throw runtime_error("Invalid precision. Allowed: fp64, fp32");
+            opts.precision = pval;
+        } else if (arg.rfind("-seed=", 0) == 0) {
+            long long sval = stoll(arg.substr(6));
+            if (sval < 0) throw runtime_error("seed must be >= 0");
+            opts.seed = sval;
         } else {
             resultsManager.addError("Unknown argument: '" + arg + "'");
             throw runtime_error("Unknown argument");
@@ -164,39 +181,59 @@ CLIOptions parseCLI(int argc, char* argv[], ResultsManager& resultsManager) {
     return opts;
 }
 
+// Whole benchmark for one value type: load, warm up, run, record.
+// The index type follows the project-wide csr_index_t (Makefile INDEX64 knob).
+template <typename ValueT>
+static void runBenchmark(const CLIOptions& opts, ResultsManager& resultsManager) {
+    typedef CSRMatrixT<ValueT, csr_index_t> MatT;
+    typedef typename MatT::index_type IndexT;
+    double duration = 0.0;
+    size_t bytesMoved = 0, flopsMoved = 0;
+
+    // Load matrix (uses the binary sidecar cache when available)
+    MatT csr;
+    csr.loadFromMTX(opts.filePath);
+
+    string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
+    resultsManager.setInformation(&csr, matrixName);
+    resultsManager.setPrecision(opts.precision);
+
+    // Generate input vector (cast to the run's value type) and a reusable,
+    // pre-touched output buffer: allocating y once outside the timed region
+    // keeps the iterations free of heap traffic and page faults.
+    unique_ptr<double[]> randomVector(generateRandomVector(csr.getCols(), -1000.0, 1000.0, opts.seed));
+    unique_ptr<ValueT[]> inputVector(new ValueT[csr.getCols()]);
+    for (IndexT i = 0; i < csr.getCols(); i++) inputVector[i] = (ValueT)randomVector[i];
+    randomVector.reset(nullptr);
+    unique_ptr<ValueT[]> outputVector(new ValueT[csr.getRows()]);
+    for (IndexT i = 0; i < csr.getRows(); i++) outputVector[i] = ValueT(0);
+
+    // Warm-up phase
+    warmUp(csr, inputVector.get(), outputVector.get(), duration, bytesMoved, flopsMoved);
+    resultsManager.setWarmupDuration(duration);
+    resultsManager.setRealTimeMetrics(bytesMoved, flopsMoved);
+
+    // Timed iterations
+    for (int i = 0; i < opts.iterations; i++) {
+        SpMV(csr, inputVector.get(), outputVector.get(), duration);
+        resultsManager.addIterationDuration(duration);
+    }
+
+    // Compute final metrics (percentiles, GFLOPS, bandwidth)
+    resultsManager.computeAllMetrics();
+}
+
 int main(int argc, char* argv[]) {
     ResultsManager resultsManager;
 
     try {
         CLIOptions opts = parseCLI(argc, argv, resultsManager);
-        double duration = 0.0;
-        size_t bytesMoved = 0, flopsMoved = 0;
-
-        // Load matrix
-        CSRMatrix csr;
-        vector<Entry> entries = readMTX(opts.filePath);
-        csr.buildFromEntries(entries);
-
-        string matrixName = opts.filePath.substr(opts.filePath.find_last_of("/\\") + 1);
-        resultsManager.setInformation(&csr, matrixName);
-
-        // Generate input vector
-        unique_ptr<double[]> inputVector(generateRandomVector(csr.getCols(), -1000.0, 1000.0));
-        unique_ptr<double[]> outputVector(nullptr);
-
-        // Warm-up phase
-        warmUp(csr, inputVector.get(), duration, bytesMoved, flopsMoved);
-        resultsManager.setWarmupDuration(duration);
-        resultsManager.setRealTimeMetrics(bytesMoved, flopsMoved);
-
-        // Timed iterations
-        for (int i = 0; i < opts.iterations; i++) {
-            outputVector.reset(SpMV(csr, inputVector.get(), duration));
-            resultsManager.addIterationDuration(duration);
-        }
 
-        // Compute final metrics (percentiles, GFLOPS, bandwidth)
-        resultsManager.computeAllMetrics();
+        // Dispatch on the value precision; everything below main is templated
+        if (opts.precision == "fp32")
+            runBenchmark<float>(opts, resultsManager);
+        else
+            runBenchmark<double>(opts, resultsManager);
 
         // print JSON output
         cout << resultsManager.toJSON() << endl;